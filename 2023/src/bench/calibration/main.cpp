@@ -0,0 +1,106 @@
+#include <iomanip>
+
+#include "calibration.h"
+#include "elven_generate.h"
+#include "elven_io.h"
+#include "elven_measure.h"
+
+// Day01 part one's previous path: std::find_if from both ends of every indexed line.
+std::size_t find_if_sum(const ElvenIO::input_type &input) {
+    std::size_t sum = 0;
+    for (const auto &line: input) {
+        const auto high = std::find_if(line.begin(), line.end(), isdigit);
+        const auto low = std::find_if(line.rbegin(), line.rend(), isdigit);
+        if (high != line.end()) { sum += (*high - '0') * 10 + (*low - '0'); }
+    }
+    return sum;
+}
+
+// Day01 part two's previous path: every position is compared against all nine words, from each end of the line.
+const std::array<std::string, 9> numbers = { "one", "two", "three", "four", "five", "six", "seven", "eight", "nine" };
+
+std::optional<std::size_t> is_number(const std::string_view line, const int i) {
+    const char c = line[i];
+    if (isdigit(c)) {
+        return std::optional(c - '0');
+    }
+    if (c == 'o' || c == 't' || c == 'f' || c == 's' || c == 'e' || c == 'n') {
+        for (int j = 0 ; j < numbers.size(); j++) {
+            if (line.substr(i).starts_with(numbers[j])) {
+                return std::optional(j + 1);
+            }
+        }
+    }
+    return std::nullopt;
+}
+
+std::size_t scan_value(const std::string_view line) {
+    std::size_t high = 0;
+    for (int i = 0 ; i < line.length(); ++i) {
+        if (const auto found = is_number(line, i); found.has_value()) {
+            high = found.value();
+            break;
+        }
+    }
+    for (int i = line.length() - 1 ; i >= 0; --i) {
+        if (const auto found = is_number(line, i); found.has_value()) { return high * 10 + found.value(); }
+    }
+    throw std::runtime_error("number not found");
+}
+
+// Every path sums the values, so the checksums must agree and nothing is optimized away.
+std::size_t scan_sum(const ElvenIO::input_type &input) {
+    std::size_t sum = 0;
+    for (const auto &line: input) { sum += scan_value(line); }
+    return sum;
+}
+
+std::size_t automaton_sum(const ElvenIO::input_type &input) {
+    std::size_t sum = 0;
+    for (const auto &line: input) { sum += Calibration::recovered_calibration_value(line); }
+    return sum;
+}
+
+void report(const std::string &label, const std::size_t checksum, const ElvenMeasure::Time time, const std::size_t bytes) {
+    const auto ns = static_cast<double>(std::max<long long>(time.count(), 1));
+    std::cout << label << " : " << ElvenMeasure::cast_time(time) << " (checksum " << checksum << ", "
+              << std::fixed << std::setprecision(1) << bytes * 1'000 / ns << " MB/s)" << std::endl;
+}
+
+// Single-threaded day01 over a file or a generated calibration document of about `megabytes` (1024 for the 1 GB
+// run). Part one compares find_if per indexed line with the block kernel over the buffer, part two the word scan,
+// the automaton per indexed line and the batched automaton over the buffer. The per-line paths also need the line
+// index, timed on its own since the runner counts it as I/O.
+// Usage: bench_calibration [file] | bench_calibration --generate [megabytes=64] [seed=1]
+int main(int argc, char** argv) {
+    ElvenIO::input_type input;
+    if (argc > 1 && std::string_view(argv[1]) != "--generate") {
+        input = ElvenIO::read_mapped(argv[1]);
+    } else {
+        const std::size_t megabytes = argc > 2 ? std::stoul(argv[2]) : 64;
+        const std::uint64_t seed = argc > 3 ? std::stoull(argv[3]) : 1;
+        // Generated lines average about 26 bytes.
+        input = ElvenGenerate::generate_input(1, megabytes * 1024 * 1024 / 26, seed);
+    }
+    std::cout << "Input     : " << input.size() << " lines, " << input.size_bytes() << " bytes" << std::endl;
+
+    const auto [index, index_time] = ElvenMeasure::execute(
+        [&input] { return ElvenIO::index_lines(input.buffer()).size(); }, 3
+    );
+    report("Index    ", index, index_time, input.size_bytes());
+    const auto [find_if, find_if_time] = ElvenMeasure::execute([&input] { return find_if_sum(input); }, 3);
+    report("Find-if  ", find_if, find_if_time, input.size_bytes());
+    const auto [kernel, kernel_time] = ElvenMeasure::execute(
+        [&input] { return Calibration::calibration_sum(input.buffer()); }, 3
+    );
+    report("Kernel   ", kernel, kernel_time, input.size_bytes());
+    const auto [scan, scan_time] = ElvenMeasure::execute([&input] { return scan_sum(input); }, 3);
+    report("Scan     ", scan, scan_time, input.size_bytes());
+    const auto [lines, lines_time] = ElvenMeasure::execute([&input] { return automaton_sum(input); }, 3);
+    report("Automaton", lines, lines_time, input.size_bytes());
+    const auto [batched, batched_time] = ElvenMeasure::execute(
+        [&input] { return Calibration::recovered_calibration_sum(input.buffer()); }, 3
+    );
+    report("Batched  ", batched, batched_time, input.size_bytes());
+    return find_if == kernel && scan == lines && lines == batched ? 0 : 1;
+}
@@ -0,0 +1,87 @@
+#include <deque>
+#include <iomanip>
+#include <random>
+#include <set>
+
+#include "elven_measure.h"
+#include "elven_utils.h"
+
+typedef ElvenUtils::Map Map;
+typedef ElvenUtils::Point Point;
+
+constexpr char WALL = Map::BLOCKED;
+constexpr char PAINT = 'X';
+// The set-based BFS needs a node per cell, past this size it would take minutes and gigabytes.
+constexpr std::size_t LEGACY_MAX_SIZE = 2000;
+
+Map random_map(const std::size_t size, const int wall_percent, const unsigned seed) {
+    Map map(size, size);
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution percent(0, 99);
+    for (ElvenUtils::Y y = 0; y < size; ++y) {
+        for (auto &cell : map.row(y)) {
+            if (percent(generator) < wall_percent) { cell = WALL; }
+        }
+    }
+    // Keep the start out of a walled-in pocket.
+    for (ElvenUtils::Y y = 0; y < std::min<std::size_t>(size, 3); ++y) {
+        std::ranges::fill(map.row(y).first(std::min<std::size_t>(size, 3)), Map::EMPTY);
+    }
+    return map;
+}
+
+// Per-cell BFS with a deque queue and a std::set of visited points, as Map::paint_exterior used to fill.
+std::size_t legacy_fill(Map &map) {
+    std::set<Point> visited_cells;
+    std::deque<Point> explore_cells;
+    explore_cells.emplace_back(0, 0);
+    visited_cells.insert(Point(0, 0));
+    map.set(0, 0, PAINT);
+    while (!explore_cells.empty()) {
+        const auto point = explore_cells.front();
+        explore_cells.pop_front();
+        for (const auto &next : {Point(point.x, point.north()), Point(point.x, point.south()), Point(point.east(), point.y), Point(point.west(), point.y)}) {
+            if (map.in_boundary(next) && map.at(next) == Map::EMPTY && !visited_cells.contains(next)) {
+                explore_cells.push_back(next);
+                map.set(next, PAINT);
+                visited_cells.insert(next);
+            }
+        }
+    }
+    return visited_cells.size();
+}
+
+std::size_t scanline_fill(Map &map) {
+    return ElvenUtils::flood_fill(map, Point(0, 0), [](const char cell) { return cell == Map::EMPTY; }, PAINT);
+}
+
+void report(const std::string &label, const std::size_t filled, const ElvenMeasure::Time time) {
+    const auto ns = static_cast<double>(std::max<long long>(time.count(), 1));
+    std::cout << label << " : " << ElvenMeasure::cast_time(time) << " (" << filled << " cells, "
+              << std::fixed << std::setprecision(1) << filled * 1'000 / ns << " Mcells/s)" << std::endl;
+}
+
+// Usage: bench_flood_fill [size=10000] [wall_percent=25] [seed=1]
+int main(int argc, char** argv) {
+    const std::size_t size = argc > 1 ? std::stoul(argv[1]) : 10'000;
+    const int wall_percent = argc > 2 ? std::stoi(argv[2]) : 25;
+    const unsigned seed = argc > 3 ? std::stoul(argv[3]) : 1;
+
+    const auto map = random_map(size, wall_percent, seed);
+    std::cout << "Grid  : " << size << "x" << size << ", " << wall_percent << "% walls" << std::endl;
+
+    auto [scanline_filled, scanline_time] = ElvenMeasure::execute([&map] {
+        Map painted(map);
+        return scanline_fill(painted);
+    }, 3);
+    report("Scanline", scanline_filled, scanline_time);
+
+    if (size <= LEGACY_MAX_SIZE) {
+        auto [legacy_filled, legacy_time] = ElvenMeasure::execute([&map] {
+            Map painted(map);
+            return legacy_fill(painted);
+        });
+        report("Set BFS ", legacy_filled, legacy_time);
+    }
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <iomanip>
+#include <random>
+#include <sstream>
+
+#include "elven_io.h"
+#include "elven_measure.h"
+#include "elven_parse.h"
+
+// Lines of whitespace-separated integers, the shape of days 05, 06, 09 and 2024 day01, each up to `digits` long.
+std::string random_input(const std::size_t lines, const int digits, const unsigned seed) {
+    std::mt19937 generator(seed);
+    std::uniform_int_distribution<long long> value(-999'999'999, 999'999'999);
+    std::uniform_int_distribution width(1, digits);
+    std::uniform_int_distribution<std::size_t> count(4, 21);
+    std::string text;
+    for (std::size_t line = 0; line < lines; ++line) {
+        const auto numbers = count(generator);
+        for (std::size_t i = 0; i < numbers; ++i) {
+            long long number = value(generator);
+            for (int d = width(generator); d < 9; ++d) { number /= 10; }
+            text += std::to_string(number);
+            text += i + 1 == numbers ? '\n' : ' ';
+        }
+    }
+    return text;
+}
+
+// Every parser sums what it reads, so the checksums must agree and nothing is optimized away.
+long long stringstream_sum(const ElvenIO::input_type &input) {
+    long long sum = 0;
+    for (const auto &line: input) {
+        std::stringstream stream;
+        stream << line;
+        long long value;
+        while (stream >> value) { sum += value; }
+    }
+    return sum;
+}
+
+long long from_chars_sum(const ElvenIO::input_type &input) {
+    long long sum = 0;
+    for (const auto &line: input) {
+        const auto *position = line.data();
+        const auto *last = line.data() + line.size();
+        while (position != last) {
+            while (position != last && *position == ' ') { ++position; }
+            long long value = 0;
+            const auto [end, error] = std::from_chars(position, last, value);
+            if (error != std::errc()) { break; }
+            sum += value;
+            position = end;
+        }
+    }
+    return sum;
+}
+
+long long cursor_sum(const ElvenIO::input_type &input) {
+    long long sum = 0;
+    for (const auto &line: input) {
+        ElvenParse::Cursor cursor(line);
+        while (const auto value = cursor.try_read_int<long long>()) { sum += *value; }
+    }
+    return sum;
+}
+
+void report(const std::string &label, const long long checksum, const ElvenMeasure::Time time, const std::size_t bytes) {
+    const auto ns = static_cast<double>(std::max<long long>(time.count(), 1));
+    std::cout << label << " : " << ElvenMeasure::cast_time(time) << " (checksum " << checksum << ", "
+              << std::fixed << std::setprecision(1) << bytes * 1'000 / ns << " MB/s)" << std::endl;
+}
+
+// Parse-only timings over an already indexed input, either a file or generated lines.
+// Usage: bench_parse [file] | bench_parse --generate [lines=200000] [digits=9] [seed=1]
+int main(int argc, char** argv) {
+    ElvenIO::input_type input;
+    if (argc > 1 && std::string_view(argv[1]) != "--generate") {
+        input = ElvenIO::read_mapped(argv[1]);
+    } else {
+        const std::size_t lines = argc > 2 ? std::stoul(argv[2]) : 200'000;
+        const int digits = argc > 3 ? std::stoi(argv[3]) : 9;
+        const unsigned seed = argc > 4 ? std::stoul(argv[4]) : 1;
+        const auto text = std::make_shared<const std::string>(random_input(lines, digits, seed));
+        input = ElvenIO::input_type(text, *text, "generated");
+    }
+    std::cout << "Input  : " << input.size() << " lines, " << input.size_bytes() << " bytes" << std::endl;
+
+    const auto [stream_sum, stream_time] = ElvenMeasure::execute([&input] { return stringstream_sum(input); }, 3);
+    report("Stream ", stream_sum, stream_time, input.size_bytes());
+    const auto [chars_sum, chars_time] = ElvenMeasure::execute([&input] { return from_chars_sum(input); }, 3);
+    report("Chars  ", chars_sum, chars_time, input.size_bytes());
+    const auto [parse_sum, parse_time] = ElvenMeasure::execute([&input] { return cursor_sum(input); }, 3);
+    report("Cursor ", parse_sum, parse_time, input.size_bytes());
+    return 0;
+}
@@ -0,0 +1,196 @@
+// Scaling curves of every part over generated inputs of doubling size, every day linked in like elven_runner:
+//   bench_scaling [--steps=6] [--budget-ms=1000] [--seed=1] [day|first-last]...
+// Each part's best time per size is fitted to O(n), O(n log n) and O(n^2) with n the input bytes, and flagged when
+// its log-log slope is clearly steeper than the complexity the puzzle allows. A day stops growing once a run takes
+// longer than the budget, the size it stopped at is the one that breaks first.
+
+#include <cmath>
+#include <iomanip>
+
+#include "elven_generate.h"
+#include "elven_runner.h"
+
+enum class Complexity { linear, linearithmic, quadratic };
+
+constexpr std::array<Complexity, 3> COMPLEXITIES{Complexity::linear, Complexity::linearithmic, Complexity::quadratic};
+
+std::string complexity_name(const Complexity complexity) {
+    switch (complexity) {
+        case Complexity::linear: return "O(n)";
+        case Complexity::linearithmic: return "O(n log n)";
+        case Complexity::quadratic: return "O(n^2)";
+    }
+    return "?";
+}
+
+// Log-log slope of each model over the measured sizes, n log n only bends a linear curve up slightly.
+double model_slope(const Complexity complexity) {
+    switch (complexity) {
+        case Complexity::linear: return 1.0;
+        case Complexity::linearithmic: return 1.1;
+        case Complexity::quadratic: return 2.0;
+    }
+    return 1.0;
+}
+
+// Caches alone bend a linear curve up a little once the input outgrows them, only a steeper slope is flagged.
+constexpr double SLOPE_TOLERANCE = 0.3;
+
+double growth(const Complexity complexity, const double n) {
+    switch (complexity) {
+        case Complexity::linear: return n;
+        case Complexity::linearithmic: return n * std::log2(std::max(n, 2.0));
+        case Complexity::quadratic: return n * n;
+    }
+    return n;
+}
+
+// First generator size of each day, picked so the smallest input is a few KB, and the complexity each part should
+// reach on that input. Only day14's cycle search and day16's every-entry search are inherently above n log n. Day06
+// has no case: its races join into a single number for part two, so the input cannot grow.
+struct Case {
+    int day;
+    std::size_t start_size;
+    std::array<Complexity, 2> expected;
+};
+
+constexpr Complexity N = Complexity::linear;
+constexpr Complexity N_LOG_N = Complexity::linearithmic;
+constexpr Complexity N2 = Complexity::quadratic;
+
+const std::vector<Case> CASES{
+    {1, 2000, {N, N}}, {2, 500, {N, N}}, {3, 128, {N, N}}, {4, 250, {N, N}},
+    {5, 16, {N_LOG_N, N_LOG_N}}, {7, 1000, {N_LOG_N, N_LOG_N}}, {8, 500, {N_LOG_N, N_LOG_N}},
+    {9, 500, {N, N}}, {10, 128, {N, N}}, {11, 64, {N, N}}, {12, 200, {N, N}},
+    {13, 32, {N, N}}, {14, 32, {N, N2}}, {15, 2000, {N, N}}, {16, 32, {N, N2}},
+    {17, 32, {N_LOG_N, N_LOG_N}}, {18, 250, {N, N}}, {19, 100, {N_LOG_N, N_LOG_N}}, {20, 2, {N, N}},
+};
+
+struct Point {
+    double bytes;
+    double ns;
+};
+
+struct Fit {
+    Complexity complexity;
+    // Least squares slope of log time over log bytes, 1 for linear and 2 for quadratic growth.
+    double slope;
+};
+
+// Fits t = c * g(n) in log space, where every size weighs the same, and keeps the model with the smallest residual.
+Fit fit(const std::vector<Point> &points) {
+    Fit best{Complexity::linear, 0};
+    double best_residual = std::numeric_limits<double>::infinity();
+    for (const auto complexity: COMPLEXITIES) {
+        double offset = 0;
+        for (const auto &[bytes, ns]: points) { offset += std::log(ns) - std::log(growth(complexity, bytes)); }
+        offset /= static_cast<double>(points.size());
+        double residual = 0;
+        for (const auto &[bytes, ns]: points) {
+            const auto error = std::log(ns) - offset - std::log(growth(complexity, bytes));
+            residual += error * error;
+        }
+        if (residual < best_residual) {
+            best_residual = residual;
+            best.complexity = complexity;
+        }
+    }
+
+    double mean_x = 0;
+    double mean_y = 0;
+    for (const auto &[bytes, ns]: points) {
+        mean_x += std::log(bytes) / static_cast<double>(points.size());
+        mean_y += std::log(ns) / static_cast<double>(points.size());
+    }
+    double covariance = 0;
+    double variance = 0;
+    for (const auto &[bytes, ns]: points) {
+        covariance += (std::log(bytes) - mean_x) * (std::log(ns) - mean_y);
+        variance += (std::log(bytes) - mean_x) * (std::log(bytes) - mean_x);
+    }
+    best.slope = variance > 0 ? covariance / variance : 0;
+    return best;
+}
+
+std::string cast_bytes(const double bytes) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1);
+    if (bytes >= 1024 * 1024) {
+        text << bytes / (1024 * 1024) << "MB";
+    } else {
+        text << bytes / 1024 << "KB";
+    }
+    return text.str();
+}
+
+// The generator size of step `step`: doubled per step, or scaled by sqrt(2) for grid sides so the bytes double.
+std::size_t step_size(const Case &scaling_case, const std::size_t step) {
+    const auto factor = std::string_view(ElvenGenerate::generator(scaling_case.day).unit) == "side"
+        ? std::pow(std::sqrt(2.0), step)
+        : std::pow(2.0, step);
+    return static_cast<std::size_t>(std::llround(static_cast<double>(scaling_case.start_size) * factor));
+}
+
+int main(const int argc, char** argv) {
+    std::size_t steps = 6;
+    ElvenMeasure::Time budget = std::chrono::milliseconds(1000);
+    std::uint64_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view argument = argv[i];
+        if (argument.starts_with("--steps=")) { steps = std::stoul(std::string(argument.substr(8))); }
+        if (argument.starts_with("--budget-ms=")) { budget = std::chrono::milliseconds(std::stoul(std::string(argument.substr(12)))); }
+        if (argument.starts_with("--seed=")) { seed = std::stoull(std::string(argument.substr(7))); }
+    }
+
+    std::vector<std::string> flagged;
+    for (const auto number: ElvenRunner::selected_days(argc, argv)) {
+        const auto &day = ElvenRunner::registered_day(number);
+        const auto scaling_case = std::ranges::find(CASES, number, &Case::day);
+        if (scaling_case == CASES.end()) {
+            std::cout << "Day " << number << " : no scaling case" << std::endl;
+            continue;
+        }
+
+        std::array<std::vector<Point>, 2> curves;
+        std::array<bool, 2> over_budget{};
+        for (std::size_t step = 0; step < steps && !(over_budget[0] && over_budget[1]); ++step) {
+            const auto input = ElvenGenerate::generate_input(number, step_size(*scaling_case, step), seed);
+            for (std::size_t i = 0; i < 2; ++i) {
+                const auto solver = day.parts()[i];
+                if (solver == nullptr || over_budget[i]) { continue; }
+                const auto [_, timing] = ElvenMeasure::execute([solver, &input] { return solver(input); }, 3);
+                curves[i].push_back({static_cast<double>(input.size_bytes()), static_cast<double>(std::max<long long>(timing.min().count(), 1))});
+                over_budget[i] = timing.min() > budget;
+            }
+        }
+
+        for (std::size_t i = 0; i < 2; ++i) {
+            const auto &curve = curves[i];
+            if (curve.empty()) { continue; }
+            const auto label = "Day " + std::to_string(number) + " Part" + std::to_string(i + 1);
+            std::cout << label << " :";
+            for (std::size_t j = 0; j < curve.size(); ++j) {
+                std::cout << (j == 0 ? " " : ", ") << cast_bytes(curve[j].bytes) << " "
+                          << ElvenMeasure::cast_time(ElvenMeasure::Time(static_cast<long long>(curve[j].ns)));
+            }
+            std::cout << std::endl;
+            if (over_budget[i]) { std::cout << "       over budget at " << cast_bytes(curve.back().bytes) << std::endl; }
+            if (curve.size() < 3) {
+                std::cout << "       too few sizes to fit" << std::endl;
+                continue;
+            }
+
+            const auto [complexity, slope] = fit(curve);
+            const auto expected = scaling_case->expected[i];
+            const bool worse = slope > model_slope(expected) + SLOPE_TOLERANCE;
+            std::cout << "       fits " << complexity_name(complexity) << " (slope " << std::fixed << std::setprecision(2)
+                      << slope << std::defaultfloat << "), expected " << complexity_name(expected)
+                      << (worse ? "  << WORSE" : "") << std::endl;
+            if (worse) { flagged.push_back(label + " " + complexity_name(complexity)); }
+        }
+    }
+
+    std::cout << std::endl << "Worse than expected: " << (flagged.empty() ? "none" : "") << std::endl;
+    for (const auto &label: flagged) { std::cout << "  " << label << std::endl; }
+    return 0;
+}
@@ -0,0 +1,197 @@
+#ifndef DAY01_CALIBRATION_H
+#define DAY01_CALIBRATION_H
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "elven_utils.h"
+
+// Calibration values of day01: the first and last digit of a line, for part two spelled out or not.
+namespace Calibration {
+
+    // Part one's sum over every line of a newline-separated text, with the same line splitting as ElvenIO. The text is
+    // classified SCAN_BLOCK bytes at a time into a digit and a newline mask in one pass; each line's first and last
+    // digits are the lowest and highest digit bits between two newline bits, so no line is ever looked at bytewise.
+    // A line without digits counts 0.
+    inline std::size_t calibration_sum(const std::string_view text) {
+        constexpr auto BLOCK = ElvenUtils::SCAN_BLOCK;
+        std::size_t sum = 0;
+        int first = -1;
+        int last = 0;
+        const auto scan_block = [&sum, &first, &last](const char *block) {
+            auto digits = ElvenUtils::range_mask(block, '0', '9');
+            auto newlines = ElvenUtils::match_mask(block, '\n');
+            while (newlines != 0) {
+                const auto newline = std::countr_zero(newlines);
+                // Every bit up to and including the newline, written so a newline in bit 63 does not shift by 64.
+                const auto line = (std::uint64_t{2} << newline) - 1;
+                if (const auto line_digits = digits & line; line_digits != 0) {
+                    if (first < 0) { first = block[std::countr_zero(line_digits)] - '0'; }
+                    last = block[63 - std::countl_zero(line_digits)] - '0';
+                }
+                if (first >= 0) { sum += first * 10 + last; }
+                first = -1;
+                digits &= ~line;
+                newlines &= newlines - 1;
+            }
+            if (digits != 0) {
+                if (first < 0) { first = block[std::countr_zero(digits)] - '0'; }
+                last = block[63 - std::countl_zero(digits)] - '0';
+            }
+        };
+
+        std::size_t i = 0;
+        for (; i + BLOCK <= text.size(); i += BLOCK) { scan_block(text.data() + i); }
+        if (i < text.size()) {
+            // The tail is padded with '\0', which is neither a digit nor a newline.
+            std::array<char, BLOCK> tail{};
+            std::memcpy(tail.data(), text.data() + i, text.size() - i);
+            scan_block(tail.data());
+        }
+        if (first >= 0) { sum += first * 10 + last; }
+        return sum;
+    }
+
+    // The digits and their words, each matching its index.
+    constexpr std::array<std::string_view, 10> DIGITS{"0", "1", "2", "3", "4", "5", "6", "7", "8", "9"};
+    constexpr std::array<std::string_view, 10> DIGIT_WORDS{
+        "", "one", "two", "three", "four", "five", "six", "seven", "eight", "nine"
+    };
+
+    // Aho-Corasick automaton over every digit and digit word, read forward or backward, compiled into a full
+    // transition table at build time: a scan is one lookup per byte and stops at the first state that ends a pattern.
+    // No pattern contains another, so the first pattern to end is also the first to start.
+    class Automaton {
+    public:
+        static constexpr std::uint8_t NO_MATCH = 0xFF;
+        // The root, one state per pattern character and one column per distinct character plus one for the rest.
+        static constexpr std::size_t MAX_STATES = 48;
+        static constexpr std::size_t MAX_COLUMNS = 32;
+
+    private:
+        std::array<std::uint8_t, 256> columns{};
+        std::array<std::array<std::uint8_t, MAX_COLUMNS>, MAX_STATES> transitions{};
+        std::array<std::uint8_t, MAX_STATES> matches{};
+
+        constexpr void add_pattern(const std::string_view pattern, const bool reversed, const std::uint8_t value,
+                                   std::array<std::array<int, MAX_COLUMNS>, MAX_STATES> &children,
+                                   std::size_t &state_count, std::size_t &column_count) {
+            std::size_t state = 0;
+            for (std::size_t i = 0; i < pattern.size(); ++i) {
+                const auto c = static_cast<unsigned char>(reversed ? pattern[pattern.size() - 1 - i] : pattern[i]);
+                if (columns[c] == 0) { columns[c] = static_cast<std::uint8_t>(column_count++); }
+                auto &child = children[state][columns[c]];
+                if (child < 0) { child = static_cast<int>(state_count++); }
+                state = static_cast<std::size_t>(child);
+            }
+            matches[state] = value;
+        }
+
+    public:
+        constexpr explicit Automaton(const bool reversed) {
+            std::array<std::array<int, MAX_COLUMNS>, MAX_STATES> children{};
+            for (auto &row: children) { row.fill(-1); }
+            matches.fill(NO_MATCH);
+            std::size_t state_count = 1;
+            std::size_t column_count = 1;
+            for (std::uint8_t value = 0; value < DIGITS.size(); ++value) {
+                add_pattern(DIGITS[value], reversed, value, children, state_count, column_count);
+                if (!DIGIT_WORDS[value].empty()) {
+                    add_pattern(DIGIT_WORDS[value], reversed, value, children, state_count, column_count);
+                }
+            }
+
+            // Breadth first, so a state's failure link and its transitions are complete before any deeper state
+            // copies them.
+            std::array<std::uint8_t, MAX_STATES> failures{};
+            std::array<std::uint8_t, MAX_STATES> queue{};
+            std::size_t head = 0;
+            std::size_t tail = 0;
+            for (std::size_t column = 0; column < MAX_COLUMNS; ++column) {
+                const auto child = children[0][column];
+                transitions[0][column] = child < 0 ? 0 : static_cast<std::uint8_t>(child);
+                if (child > 0) { queue[tail++] = static_cast<std::uint8_t>(child); }
+            }
+            while (head < tail) {
+                const auto state = queue[head++];
+                if (matches[state] == NO_MATCH) { matches[state] = matches[failures[state]]; }
+                for (std::size_t column = 0; column < MAX_COLUMNS; ++column) {
+                    const auto child = children[state][column];
+                    const auto fallback = transitions[failures[state]][column];
+                    if (child < 0) {
+                        transitions[state][column] = fallback;
+                    } else {
+                        failures[child] = fallback;
+                        transitions[state][column] = static_cast<std::uint8_t>(child);
+                        queue[tail++] = static_cast<std::uint8_t>(child);
+                    }
+                }
+            }
+        }
+
+        [[nodiscard]] constexpr std::uint8_t next(const std::uint8_t state, const char c) const {
+            return transitions[state][columns[static_cast<unsigned char>(c)]];
+        }
+        // The digit the pattern ending on entering `state` stands for, NO_MATCH when none ends there.
+        [[nodiscard]] constexpr std::uint8_t match(const std::uint8_t state) const { return matches[state]; }
+    };
+
+    constexpr Automaton FORWARD(false);
+    constexpr Automaton BACKWARD(true);
+
+    // First digit of [first, last), scanning forward, NO_MATCH when there is none.
+    constexpr std::uint8_t first_digit(const char *first, const char *last) {
+        std::uint8_t state = 0;
+        for (; first != last; ++first) {
+            state = FORWARD.next(state, *first);
+            if (const auto digit = FORWARD.match(state); digit != Automaton::NO_MATCH) { return digit; }
+        }
+        return Automaton::NO_MATCH;
+    }
+
+    // Last digit of [first, last), scanning backward from the end, NO_MATCH when there is none.
+    constexpr std::uint8_t last_digit(const char *first, const char *last) {
+        std::uint8_t state = 0;
+        while (last != first) {
+            state = BACKWARD.next(state, *--last);
+            if (const auto digit = BACKWARD.match(state); digit != Automaton::NO_MATCH) { return digit; }
+        }
+        return Automaton::NO_MATCH;
+    }
+
+    constexpr std::size_t recovered_calibration_value(const std::string_view line) {
+        const auto *first = line.data();
+        const auto *last = line.data() + line.size();
+        const auto high = first_digit(first, last);
+        if (high == Automaton::NO_MATCH) { throw std::runtime_error("number not found in: " + std::string(line)); }
+        return high * 10 + last_digit(first, last);
+    }
+
+    static_assert(recovered_calibration_value("two1nine") == 29);
+    static_assert(recovered_calibration_value("eightwothree") == 83);
+    static_assert(recovered_calibration_value("zoneight234") == 14);
+    static_assert(recovered_calibration_value("7pqrstsixteen") == 76);
+    static_assert(recovered_calibration_value("oneight") == 18);
+
+    // The batched form: the sum over every line of a newline-separated text, with the same line splitting as
+    // ElvenIO. Each line's end is found with memchr, then it is scanned forward from its start and backward from its
+    // end, so no line index is built.
+    inline std::size_t recovered_calibration_sum(const std::string_view text) {
+        std::size_t sum = 0;
+        const auto *position = text.data();
+        const auto *end = text.data() + text.size();
+        while (position < end) {
+            const auto *newline = static_cast<const char *>(std::memchr(position, '\n', end - position));
+            const auto *line_end = newline == nullptr ? end : newline;
+            sum += recovered_calibration_value({position, static_cast<std::size_t>(line_end - position)});
+            position = line_end + 1;
+        }
+        return sum;
+    }
+}
+#endif //DAY01_CALIBRATION_H
@@ -2,70 +2,67 @@
 
 #include "elven_io.h"
 #include "elven_measure.h"
+#include "elven_parallel.h"
+#include "elven_runner.h"
+#include "calibration.h"
 
+namespace {
+
+std::size_t calibration_value(const std::string_view line) {
+    auto high = std::find_if(line.begin(), line.end(), isdigit);
+    auto low = std::find_if(line.rbegin(), line.rend(), isdigit);
+    return (*high - '0') * 10 + (*low - '0');
+}
+
+// Straight over the mapped buffer with the block kernel, one slice per task, the line index is never read. The
+// kernel's masks take the widest of AVX2, SSE2 and scalar the build allows.
 std::size_t part1(const ElvenIO::input_type &input) {
+    const auto chunks = ElvenIO::line_chunks(input.buffer(), ElvenParallel::thread_count() * 4);
+    return ElvenParallel::transform_reduce(
+        chunks.begin(),
+        chunks.end(),
+        static_cast<std::size_t>(0),
+        std::plus(),
+        Calibration::calibration_sum,
+        1
+    );
+}
+
+std::size_t part1(ElvenIO::LineStream &&input) {
     return std::transform_reduce(
         input.begin(),
         input.end(),
-        0,
+        static_cast<std::size_t>(0),
         std::plus(),
-        [](auto line) {
-            auto high = std::find_if(line.begin(), line.end(), isdigit);
-            auto low = std::find_if(line.rbegin(), line.rend(), isdigit);
-            return (*high - '0') * 10 + (*low - '0');
-        }
+        calibration_value
     );
 }
 
-const std::array<std::string, 9> numbers = { "one", "two", "three", "four", "five", "six", "seven", "eight", "nine" };
-
-std::optional<std::size_t> is_number(const std::string &line, const int i) {
-    const char c = line[i];
-    if (isdigit(c)) {
-        return std::optional(c - '0');
-    }
-    if (c == 'o' || c == 't' || c == 'f' || c == 's' || c == 'e' || c == 'n') {
-        for (int j = 0 ; j < numbers.size(); j++) {
-            if (strncmp(&line[i], numbers[j].c_str(), numbers[j].length()) == 0) {
-                return std::optional(j + 1);
-            }
-        }
-    }
-    return std::nullopt;
-}
-
-std::size_t find_high(const std::string &line) {
-    for (int i = 0 ; i < line.length(); ++i) {
-        if (const auto high = is_number(line, i); high.has_value()) { return high.value(); }
-    }
-    throw std::runtime_error("number not found");
-}
-
-std::size_t find_low(const std::string &line) {
-    for (int i = line.length() - 1 ; i >= 0; --i) {
-        if (const auto low = is_number(line, i); low.has_value()) { return low.value(); }
-    }
-    throw std::runtime_error("number not found");
+// Over the line index the runner already built: the automaton per indexed line beats the batched
+// recovered_calibration_sum, which has to find every line end again (bench_calibration).
+std::size_t part2(const ElvenIO::input_type &input) {
+    return ElvenParallel::transform_reduce(
+        input.begin(),
+        input.end(),
+        static_cast<std::size_t>(0),
+        std::plus(),
+        Calibration::recovered_calibration_value
+    );
 }
 
-std::size_t part2(const ElvenIO::input_type &input) {
+std::size_t part2(ElvenIO::LineStream &&input) {
     return std::transform_reduce(
         input.begin(),
         input.end(),
-        0,
+        static_cast<std::size_t>(0),
         std::plus(),
-        [](auto line) { return find_high(line) * 10 + find_low(line); }
+        Calibration::recovered_calibration_value
     );
 }
+}
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 10);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 10);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_DAY(
+    1, 10,
+    ELVEN_SOLVER(part1), ELVEN_SOLVER(part2),
+    ELVEN_STREAM_SOLVER(part1), ELVEN_STREAM_SOLVER(part2)
+)
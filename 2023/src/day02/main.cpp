@@ -1,68 +1,98 @@
-#include <sstream>
-#include <numeric>
+#include <array>
 
 #include "elven_io.h"
 #include "elven_measure.h"
+#include "elven_parallel.h"
+#include "elven_parse.h"
+#include "elven_runner.h"
 
-auto parse_input(const ElvenIO::input_type &input) {
-    std::vector<std::vector<size_t>> games;
-
-    for (const auto &line: input) {
-        std::stringstream stream;
-        std::string color;
-        std::size_t number;
-        stream << line;
-        stream >> color >> color;
-        std::vector<std::size_t> colors(3, 0);
-        while(stream >> number >> color) {
-            switch (color[0]) {
-                case 'r':
-                    colors[0] = std::max(colors[0], number);
-                break;
-                case 'g':
-                    colors[1] = std::max(colors[1], number);
-                break;
-                case 'b':
-                    colors[2] = std::max(colors[2], number);
-                break;
-            }
-        }
-        games.emplace_back(colors);
+namespace {
+
+constexpr std::size_t MAX_RED = 12;
+constexpr std::size_t MAX_GREEN = 13;
+constexpr std::size_t MAX_BLUE = 14;
+
+// Both answers at once: the ids of the possible games and the powers of every game's minimal cube set.
+struct GameTotals {
+    std::size_t possible_ids = 0;
+    std::size_t powers = 0;
+
+    friend GameTotals operator+(const GameTotals &left, const GameTotals &right) {
+        return {left.possible_ids + right.possible_ids, left.powers + right.powers};
     }
+};
 
-    return std::move(games);
-}
+// Adds one "Game <id>: <count> <color>, ...; ..." record in a single pass over its bytes. After the id every cube is
+// "<separator> <count> <color>", so the parser jumps two bytes to each count and, from the color's first letter, over
+// the whole word to the next separator. Nothing is extracted or kept beyond the record's three maxima.
+void add_game(const std::string_view record, GameTotals &totals) {
+    constexpr std::string_view GAME_PREFIX = "Game ";
+    // Lengths of "red", "green" and "blue".
+    constexpr std::array<std::size_t, 3> COLOR_LENGTHS{3, 5, 4};
+    if (record.size() <= GAME_PREFIX.size()) { return; }
 
-auto part1(const ElvenIO::input_type &input) {
-    size_t sum = 0;
-    const auto games = parse_input(input);
-    for (int i = 0; i < games.size(); ++i) {
-        if (games[i][0] <= 12 && games[i][1] <= 13 && games[i][2] <= 14) {
-            sum += i + 1;
+    const auto *position = record.data() + GAME_PREFIX.size();
+    const auto *end = record.data() + record.size();
+    std::size_t id = 0;
+    for (; position < end && ElvenParse::is_digit(*position); ++position) { id = id * 10 + (*position - '0'); }
+
+    std::array<std::size_t, 3> cubes{};
+    while (end - position > 2) {
+        position += 2;
+        std::size_t count = 0;
+        for (; position < end && ElvenParse::is_digit(*position); ++position) {
+            count = count * 10 + (*position - '0');
         }
+        if (++position >= end) { break; }
+        const auto color = *position == 'r' ? 0 : *position == 'g' ? 1 : 2;
+        cubes[color] = std::max(cubes[color], count);
+        position += std::min<std::size_t>(COLOR_LENGTHS[color], end - position);
     }
-    return sum;
+
+    const auto [red, green, blue] = cubes;
+    if (red <= MAX_RED && green <= MAX_GREEN && blue <= MAX_BLUE) { totals.possible_ids += id; }
+    totals.powers += red * green * blue;
+}
+
+GameTotals aggregate(const std::string_view bytes) {
+    GameTotals totals;
+    ElvenIO::for_each_line(bytes, 0, bytes.size(), [&totals](const std::string_view record) {
+        add_game(record, totals);
+    });
+    return totals;
+}
+
+// One pass over the mapped buffer, one slice of whole records per task.
+GameTotals parse_input(const ElvenIO::input_type &input) {
+    const auto chunks = ElvenIO::line_chunks(input.buffer(), ElvenParallel::thread_count() * 4);
+    return ElvenParallel::transform_reduce(chunks.begin(), chunks.end(), GameTotals{}, std::plus(), aggregate, 1);
+}
+
+// Any number of records in the constant memory of the stream's buffer.
+GameTotals aggregate_lines(ElvenIO::LineStream &&input) {
+    GameTotals totals;
+    for (const auto &line: input) { add_game(line, totals); }
+    return totals;
+}
+
+std::size_t part1(const GameTotals &totals) {
+    return totals.possible_ids;
 }
 
-auto part2(const ElvenIO::input_type &input) {
-    const auto games = parse_input(input);
-    return std::transform_reduce(
-        games.begin(),
-        games.end(),
-        0,
-        std::plus(),
-        [] (auto game) { return std::reduce(game.begin(), game.end(), 1, std::multiplies<size_t>()); }
-    );
+std::size_t part1(ElvenIO::LineStream &&input) {
+    return aggregate_lines(std::move(input)).possible_ids;
+}
+
+std::size_t part2(const GameTotals &totals) {
+    return totals.powers;
+}
+
+std::size_t part2(ElvenIO::LineStream &&input) {
+    return aggregate_lines(std::move(input)).powers;
+}
 }
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 10);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 10);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_PARSED_DAY(
+    2, 10, parse_input, part1, part2,
+    ELVEN_STREAM_SOLVER(part1), ELVEN_STREAM_SOLVER(part2)
+)
@@ -1,85 +1,184 @@
-#include <iostream>
+#include <array>
+#include <bit>
+#include <string>
+#include <vector>
 
 #include "elven_io.h"
 #include "elven_measure.h"
+#include "elven_parse.h"
+#include "elven_runner.h"
+#include "elven_utils.h"
+
+namespace {
 
 constexpr auto EMPTY = '.';
+constexpr auto GEAR = '*';
 
-size_t parse_number(const std::vector<std::string> &schematic, const int x, const int y) {
-    auto number = 0;
-    for (int i = x, mult = 1; i >= 0 && isdigit(schematic[y][i]); --i, mult *= 10) {
-        number = number + (schematic[y][i] - '0') * mult;
-    }
-    for (int i = x + 1; i < schematic[y].size() && isdigit(schematic[y][i]); ++i) {
-        number = number * 10 + (schematic[y][i] - '0');
+// Both answers at once: the sum of the part numbers and of the ratios of the gears with exactly two of them.
+struct SchematicTotals {
+    std::size_t part_numbers = 0;
+    std::size_t gear_ratios = 0;
+};
+
+// Streams a schematic through a window of three rows. Every row is copied into its slot padded with '.' to whole
+// words and classified SCAN_BLOCK bytes at a time into a digit and a symbol mask. When the row below arrives, the
+// symbol masks of the three rows are merged and dilated by one column, and each number of the middle row is read once:
+// it is a part number when the dilated mask covers any of its digits, and it is counted on every adjacent gear. A
+// row's gears are settled as it leaves the window, so memory stays at three rows whatever the height.
+class SchematicScanner {
+    typedef ElvenUtils::BitGrid::Word Word;
+    static constexpr std::size_t WINDOW = 3;
+    static constexpr std::size_t WORD_BITS = ElvenUtils::BitGrid::WORD_BITS;
+
+    struct Gear {
+        std::size_t count = 0;
+        std::size_t ratio = 1;
+    };
+
+    std::size_t width = 0;
+    std::size_t rows = 0;
+    std::array<std::string, WINDOW> window;
+    ElvenUtils::BitGrid digits{0, WINDOW};
+    ElvenUtils::BitGrid symbols{0, WINDOW};
+    std::vector<Word> around;
+    std::vector<Word> adjacent;
+    std::array<std::vector<Gear>, WINDOW> gears;
+    SchematicTotals totals;
+
+    void start(const std::size_t row_width) {
+        width = row_width;
+        digits = ElvenUtils::BitGrid(width, WINDOW);
+        symbols = ElvenUtils::BitGrid(width, WINDOW);
+        const auto words = digits.row_words(0).size();
+        around.assign(words, 0);
+        adjacent.assign(words, 0);
+        for (auto &row: window) { row.assign(words * WORD_BITS, EMPTY); }
+        for (auto &row: gears) { row.assign(width, {}); }
     }
-    return number;
-}
 
-size_t part1(const ElvenIO::input_type &schematic) {
-    size_t sum = 0;
-    for (int y = 0; y < schematic.size(); ++y) {
-        for (int x = 0; x < schematic[y].size(); ++x) {
-            if (schematic[y][x] != EMPTY && !isdigit(schematic[y][x])) {
-                for (int y_i = std::max(y-1, 0); y_i <= y+1 && y_i < schematic.size(); y_i++) {
-                    for (int x_i = std::max(x-1, 0); x_i <= x+1 && x_i < schematic[y_i].size(); x_i++) {
-                        if (isdigit(schematic[y_i][x_i]) &&
-                            (
-                                y == y_i // no extra checks on horizontal
-                                || x_i < x // no extra checks on the left corners
-                                || !isdigit(schematic[y_i][x_i-1]) // not already processed
-                            )
-                        ) {
-                            sum += parse_number(schematic,x_i, y_i);
+    [[nodiscard]] bool is_adjacent(const std::size_t x) const { return adjacent[x / WORD_BITS] >> (x % WORD_BITS) & 1; }
+
+    // Reads the numbers of row `y`, with the rows above and, unless it is the last, below it in the window.
+    void read_numbers(const std::size_t y, const bool has_below) {
+        const auto middle = y % WINDOW;
+        const auto above = (y + WINDOW - 1) % WINDOW;
+        const auto below = (y + 1) % WINDOW;
+        const auto words = around.size();
+
+        std::ranges::copy(symbols.row_words(middle), around.begin());
+        if (y > 0) { std::ranges::transform(around, symbols.row_words(above), around.begin(), std::bit_or()); }
+        if (has_below) { std::ranges::transform(around, symbols.row_words(below), around.begin(), std::bit_or()); }
+        for (std::size_t i = 0; i < words; ++i) {
+            adjacent[i] = around[i] | around[i] << 1 | around[i] >> 1
+                          | (i > 0 ? around[i - 1] >> (WORD_BITS - 1) : 0)
+                          | (i + 1 < words ? around[i + 1] << (WORD_BITS - 1) : 0);
+        }
+
+        const auto &row = window[middle];
+        const auto row_digits = digits.row_words(middle);
+        for (std::size_t i = 0; i < words; ++i) {
+            const auto carry = i > 0 ? row_digits[i - 1] >> (WORD_BITS - 1) : 0;
+            for (auto starts = row_digits[i] & ~(row_digits[i] << 1 | carry); starts != 0; starts &= starts - 1) {
+                const auto first = i * WORD_BITS + std::countr_zero(starts);
+                std::size_t number = 0;
+                auto last = first;
+                // The padding or the string's terminator ends every number.
+                for (; ElvenParse::is_digit(row[last]); ++last) { number = number * 10 + (row[last] - '0'); }
+
+                bool is_part = false;
+                for (auto x = first; x < last && !is_part; ++x) { is_part = is_adjacent(x); }
+                if (!is_part) { continue; }
+                totals.part_numbers += number;
+
+                const auto from = first > 0 ? first - 1 : first;
+                const auto to = std::min(last + 1, width);
+                const auto count_gears = [this, from, to, number](const std::size_t slot) {
+                    for (auto x = from; x < to; ++x) {
+                        if (window[slot][x] == GEAR) {
+                            ++gears[slot][x].count;
+                            gears[slot][x].ratio *= number;
                         }
                     }
-                }
+                };
+                if (y > 0) { count_gears(above); }
+                count_gears(middle);
+                if (has_below) { count_gears(below); }
             }
         }
     }
-    return sum;
-}
 
-size_t gear_ratio(const std::vector<std::string> &schematic, const int x, const int y) {
-    int found = 0;
-    size_t ratio = 1;
-    for (int y_i = std::max(y-1, 0); y_i <= y+1 && y_i < schematic.size(); y_i++) {
-        for (int x_i = std::max(x-1, 0); x_i <= x+1 && x_i < schematic[y_i].size(); x_i++) {
-            if (isdigit(schematic[y_i][x_i]) &&
-                (
-                    y == y_i // no extra checks on horizontal
-                    || x_i < x // no extra checks on the left corners
-                    || !isdigit(schematic[y_i][x_i-1]) // not already processed
-                )
-            ) {
-                ratio *= parse_number(schematic,x_i, y_i);
-                found += 1;
+    // Adds the gears of row `y` with exactly two part numbers and clears its accumulators for the next row in the slot.
+    void settle_gears(const std::size_t y) {
+        const auto slot = y % WINDOW;
+        const auto row_symbols = symbols.row_words(slot);
+        for (std::size_t i = 0; i < row_symbols.size(); ++i) {
+            for (auto word = row_symbols[i]; word != 0; word &= word - 1) {
+                auto &gear = gears[slot][i * WORD_BITS + std::countr_zero(word)];
+                if (gear.count == 2) { totals.gear_ratios += gear.ratio; }
+                gear = {};
             }
         }
     }
-    return found == 2 ? ratio : 0;
-}
 
-size_t part2(const ElvenIO::input_type &schematic) {
-    size_t sum = 0;
-    for (int y = 0; y < schematic.size(); ++y) {
-        for (int x = 0; x < schematic[y].size(); ++x) {
-            if (schematic[y][x] != EMPTY && !isdigit(schematic[y][x])) {
-                sum += gear_ratio(schematic, x, y);
-            }
+public:
+    void add_row(const std::string_view line) {
+        if (rows == 0) { start(line.size()); }
+        if (line.size() > width) { throw std::runtime_error("schematic row wider than the first: " + std::string(line)); }
+
+        const auto slot = rows % WINDOW;
+        auto &row = window[slot];
+        std::ranges::copy(line, row.begin());
+        std::fill(row.begin() + static_cast<long>(line.size()), row.end(), EMPTY);
+        const auto row_digits = digits.row_words(slot);
+        const auto row_symbols = symbols.row_words(slot);
+        for (std::size_t i = 0; i < row_digits.size(); ++i) {
+            const auto *block = row.data() + i * WORD_BITS;
+            row_digits[i] = ElvenUtils::range_mask(block, '0', '9');
+            row_symbols[i] = ~(row_digits[i] | ElvenUtils::match_mask(block, EMPTY));
         }
+
+        if (rows >= 1) { read_numbers(rows - 1, true); }
+        if (rows >= 2) { settle_gears(rows - 2); }
+        ++rows;
+    }
+
+    SchematicTotals finish() {
+        if (rows >= 1) { read_numbers(rows - 1, false); }
+        if (rows >= 2) { settle_gears(rows - 2); }
+        if (rows >= 1) { settle_gears(rows - 1); }
+        return totals;
     }
-    return sum;
+};
+
+template <class Lines>
+SchematicTotals scan_schematic(Lines &&lines) {
+    SchematicScanner scanner;
+    for (const auto &line: lines) { scanner.add_row(line); }
+    return scanner.finish();
+}
+
+SchematicTotals parse_input(const ElvenIO::input_type &input) {
+    return scan_schematic(input);
+}
+
+std::size_t part1(const SchematicTotals &totals) {
+    return totals.part_numbers;
+}
+
+std::size_t part1(ElvenIO::LineStream &&input) {
+    return scan_schematic(input).part_numbers;
+}
+
+std::size_t part2(const SchematicTotals &totals) {
+    return totals.gear_ratios;
+}
+
+std::size_t part2(ElvenIO::LineStream &&input) {
+    return scan_schematic(input).gear_ratios;
+}
 }
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 10);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 10);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_PARSED_DAY(
+    3, 10, parse_input, part1, part2,
+    ELVEN_STREAM_SOLVER(part1), ELVEN_STREAM_SOLVER(part2)
+)
@@ -1,97 +1,121 @@
-#include <set>
-#include <sstream>
+#include <array>
+#include <bitset>
 #include <numeric>
 
 #include "elven_io.h"
 #include "elven_measure.h"
+#include "elven_parallel.h"
+#include "elven_parse.h"
+#include "elven_runner.h"
 
-typedef std::vector<std::tuple<std::set<int>, std::vector<int>>> cards_type;
+namespace {
 
-void skip_header(std::stringstream &stream) {
-    std::string card_label;
-    std::string game_number;
-    stream >> card_label >> game_number;
-}
+// Card numbers are below 100, so either side of a card is one 128-bit mask and its matches are an AND and a popcount.
+constexpr std::size_t NUMBER_LIMIT = 128;
+typedef std::bitset<NUMBER_LIMIT> numbers_type;
+
+struct Card {
+    numbers_type winners;
+    numbers_type numbers;
+
+    [[nodiscard]] std::size_t matches() const { return (winners & numbers).count(); }
+};
 
-auto parse_winners(std::stringstream &stream) {
-    std::set<int> winners;
-    std::string winner;
-    while (stream >> winner && winner != "|") {
-        winners.emplace(std::stoi(winner));
+typedef std::vector<Card> cards_type;
+
+// Lines parsed per parallel task.
+constexpr std::size_t CARDS_PER_TASK = 4096;
+
+numbers_type parse_numbers(ElvenParse::Cursor &cursor) {
+    numbers_type numbers;
+    while (const auto number = cursor.try_read_int<std::size_t>()) {
+        if (*number >= NUMBER_LIMIT) { throw std::runtime_error("card number out of range: " + std::to_string(*number)); }
+        numbers.set(*number);
     }
-    return std::move(winners);
+    return numbers;
 }
 
-auto parse_cards(std::stringstream &stream) {
-    std::vector<int> cards;
-    int card;
-    while (stream >> card) {
-        cards.emplace_back(card);
-    }
-    return std::move(cards);
+Card parse_card(const std::string_view line) {
+    ElvenParse::Cursor cursor(line);
+    cursor.skip_past(':');
+    const auto winners = parse_numbers(cursor);
+    cursor.skip_past('|');
+    return {winners, parse_numbers(cursor)};
 }
 
-auto parse_input(const ElvenIO::input_type &input) {
-    cards_type cards;
-    for (const auto &line: input) {
-        std::stringstream stream;
-        stream << line;
-        skip_header(stream);
-        cards.emplace_back(parse_winners(stream), parse_cards(stream));
-    }
+cards_type parse_input(const ElvenIO::input_type &input) {
+    cards_type cards(input.size());
+    const auto task_count = (input.size() + CARDS_PER_TASK - 1) / CARDS_PER_TASK;
+    ElvenParallel::parallel_for(task_count, [&input, &cards](const std::size_t task) {
+        const auto last = std::min(input.size(), (task + 1) * CARDS_PER_TASK);
+        for (auto i = task * CARDS_PER_TASK; i < last; ++i) { cards[i] = parse_card(input[i]); }
+    });
+    return cards;
+}
 
-    return std::move(cards);
+std::size_t points(const std::size_t matches) {
+    return matches == 0 ? 0 : static_cast<std::size_t>(1) << (matches - 1);
 }
 
-size_t part1(const ElvenIO::input_type &input) {
-    const auto cards = parse_input(input);
-    return std::transform_reduce(
+// Part two's copies as a difference array: a card's copies are added to the running count once and taken off again
+// where its run of won cards ends, so each card costs O(1) whatever its matches. A run never spans more than
+// NUMBER_LIMIT cards, so the array is a ring of fixed size and memory does not grow with the card count.
+class CopyCascade {
+    static constexpr std::size_t RING = 2 * NUMBER_LIMIT;
+    std::array<std::size_t, RING> run_ends{};
+    std::size_t running = 0;
+    std::size_t card = 0;
+    std::size_t cards = 0;
+
+public:
+    void add(const std::size_t matches) {
+        auto &ending = run_ends[card % RING];
+        running -= ending;
+        ending = 0;
+        const auto copies = running + 1;
+        cards += copies;
+        running += copies;
+        run_ends[(card + 1 + matches) % RING] += copies;
+        ++card;
+    }
+
+    [[nodiscard]] std::size_t total() const { return cards; }
+};
+
+size_t part1(const cards_type &cards) {
+    return ElvenParallel::transform_reduce(
         cards.begin(),
         cards.end(),
-        0,
+        static_cast<std::size_t>(0),
         std::plus(),
-        [](auto card) {
-            auto found = std::count_if(
-                std::get<1>(card).begin(),
-                std::get<1>(card).end(),
-                [=](auto number) { return std::get<0>(card).contains(number); }
-            );
-            return found == 0 ? 0 : std::pow(2, found - 1);
-        }
+        [](const Card &card) { return points(card.matches()); }
     );
 }
 
-size_t part2(const ElvenIO::input_type &input) {
-    const auto cards = parse_input(input);
-    std::vector counts(cards.size(), 1);
-
-    for(int i = 0; i < cards.size(); ++i) {
-        auto card = cards[i];
-        const auto found = std::ranges::count_if(
-            std::get<1>(card).begin(),
-            std::get<1>(card).end(),
-            [=](auto number) { return std::get<0>(card).contains(number); }
-        );
-        const auto amount_dupes = counts[i];
-        for (int j = i + 1; j <= i + found; ++j) { counts[j] += amount_dupes; }
-    }
-
-    return std::reduce(
-        counts.begin(),
-        counts.end(),
-        0,
-        std::plus()
+size_t part1(ElvenIO::LineStream &&input) {
+    return std::transform_reduce(
+        input.begin(),
+        input.end(),
+        static_cast<std::size_t>(0),
+        std::plus(),
+        [](const auto &line) { return points(parse_card(line).matches()); }
     );
 }
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 10);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 10);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+size_t part2(const cards_type &cards) {
+    CopyCascade cascade;
+    for (const auto &card: cards) { cascade.add(card.matches()); }
+    return cascade.total();
+}
+
+size_t part2(ElvenIO::LineStream &&input) {
+    CopyCascade cascade;
+    for (const auto &line: input) { cascade.add(parse_card(line).matches()); }
+    return cascade.total();
+}
+}
+
+ELVEN_PARSED_DAY(
+    4, 10, parse_input, part1, part2,
+    ELVEN_STREAM_SOLVER(part1), ELVEN_STREAM_SOLVER(part2)
+)
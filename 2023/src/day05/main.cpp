@@ -2,12 +2,15 @@
 #include <set>
 #include <map>
 #include <iostream>
-#include <sstream>
 
 #include "elven_io.h"
 #include "elven_measure.h"
+#include "elven_parse.h"
+#include "elven_runner.h"
 
 
+namespace {
+
 typedef std::vector<long> seed_list;
 typedef std::set<long> origin_set;
 typedef std::tuple<long, long> origin_data;
@@ -16,15 +19,9 @@ typedef std::tuple<origin_set, origin_to_data_map> transformer_data;
 typedef std::vector<transformer_data> transformer_list;
 
 auto parse_seeds(const ElvenIO::input_type &input) {
-    seed_list seeds;
-
-    std::stringstream stream;
-    stream << input[0];
-    std::string header;
-    stream >> header;
-    long seed;
-    while (stream >> seed) { seeds.emplace_back(seed);  }
-    return std::move(seeds);
+    ElvenParse::Cursor cursor(input[0]);
+    cursor.skip_past(':');
+    return cursor.read_ints<long>();
 }
 
 auto parse_transformers(const ElvenIO::input_type &input) {
@@ -34,10 +31,10 @@ auto parse_transformers(const ElvenIO::input_type &input) {
         origin_set origins;
         origin_to_data_map origin_to_data;
         for (; i < input.size() && !input[i].empty(); ++i) {
-            std::stringstream stream;
-            stream << input[i];
-            long destination, origin, range;
-            stream >> destination >> origin >> range;
+            ElvenParse::Cursor cursor(input[i]);
+            const auto destination = cursor.read_int<long>();
+            const auto origin = cursor.read_int<long>();
+            const auto range = cursor.read_int<long>();
             origins.emplace(origin);
             origin_to_data[origin] = std::tuple(destination - origin, range);
         }
@@ -87,12 +84,9 @@ typedef std::vector<stage_data> stage_list;
 auto parse_seeds2(const ElvenIO::input_type &input) {
     seed_list2 seeds;
 
-    std::stringstream stream;
-    stream << input[0];
-    std::string header;
-    stream >> header;
-    long seed_start, count;
-    while (stream >> seed_start >> count) { seeds.emplace_back(seed_start, count);  }
+    ElvenParse::Cursor cursor(input[0]);
+    cursor.skip_past(':');
+    while (const auto seed_start = cursor.try_read_int<long>()) { seeds.emplace_back(*seed_start, cursor.read_int<long>());  }
     return std::move(seeds);
 }
 
@@ -102,10 +96,10 @@ auto parse_transformers2(const ElvenIO::input_type &input) {
     for (int i = 3; i < input.size(); i += 2) {
         stage_data stage;
         for (; i < input.size() && !input[i].empty(); ++i) {
-            std::stringstream stream;
-            stream << input[i];
-            long destination, origin, range;
-            stream >> destination >> origin >> range;
+            ElvenParse::Cursor cursor(input[i]);
+            const auto destination = cursor.read_int<long>();
+            const auto origin = cursor.read_int<long>();
+            const auto range = cursor.read_int<long>();
             stage.emplace_back(origin, destination, range);
         }
         std::sort(stage.begin(), stage.end());
@@ -164,15 +158,6 @@ auto part2(const ElvenIO::input_type &input) {
     }
     return min_location;
 }
+}
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 10);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 10);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_DAY(5, 10, ELVEN_SOLVER(part1), ELVEN_SOLVER(part2))
@@ -1,24 +1,23 @@
-#include <sstream>
 #include <numeric>
 
 #include "elven_io.h"
 #include "elven_measure.h"
+#include "elven_parse.h"
+#include "elven_runner.h"
+
+namespace {
 
 typedef std::tuple<size_t, size_t> race;
 
 auto parse_input(const ElvenIO::input_type &input) {
     std::vector<race> races;
 
-    std::stringstream timestream;
-    timestream << input[0];
-    std::stringstream distancestream;
-    distancestream << input[1];
-    std::string header1, header2;
-    timestream >> header1;
-    distancestream >> header2;
+    ElvenParse::Cursor times(input[0]);
+    ElvenParse::Cursor distances(input[1]);
+    times.skip_past(':');
+    distances.skip_past(':');
 
-    size_t time, distance;
-    while (timestream >> time && distancestream >> distance) { races.emplace_back(time, distance); }
+    while (const auto time = times.try_read_int<size_t>()) { races.emplace_back(*time, distances.read_int<size_t>()); }
     return races;
 }
 
@@ -62,28 +61,23 @@ auto part1(const ElvenIO::input_type &input) {
     );
 }
 
-auto parse_input_as_single_value(const ElvenIO::input_type &input) {
-    std::string time_line = input[0].substr(std::string("Time:").length());
-    std::string distance_line = input[1].substr(std::string("Distance::").length());
-    time_line.erase(std::remove_if(time_line.begin(), time_line.end(), isspace), time_line.end());
-    distance_line.erase(std::remove_if(distance_line.begin(), distance_line.end(), isspace), distance_line.end());
+// The digits of the line read as one number, the spaces between them ignored.
+size_t joined_digits(const std::string_view line) {
+    size_t value = 0;
+    for (const auto c: line) {
+        if (ElvenParse::is_digit(c)) { value = value * 10 + (c - '0'); }
+    }
+    return value;
+}
 
-    return race(std::stol(time_line), std::stol(distance_line));
+auto parse_input_as_single_value(const ElvenIO::input_type &input) {
+    return race(joined_digits(input[0]), joined_digits(input[1]));
 }
 
 auto part2(const ElvenIO::input_type &input) {
     auto [time, distance] = parse_input_as_single_value(input);
     return search_max_win_position(distance, time) - search_min_win_position(distance, time) + 1;
 }
+}
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 10);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 10);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_DAY(6, 10, ELVEN_SOLVER(part1), ELVEN_SOLVER(part2))
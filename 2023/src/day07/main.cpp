@@ -1,8 +1,11 @@
-#include <sstream>
 #include <map>
 
 #include "elven_io.h"
 #include "elven_measure.h"
+#include "elven_parse.h"
+#include "elven_runner.h"
+
+namespace {
 
 typedef size_t card_value;
 enum HandScore {
@@ -67,11 +70,9 @@ auto parse_input(const ElvenIO::input_type &input, const bool allow_jokers) {
     std::vector<play> plays;
 
     for (const auto &line: input) {
-        std::stringstream stream;
-        stream << line;
-        std::string hand;
-        bid_value bid;
-        stream >> hand >> bid;
+        ElvenParse::Cursor cursor(line);
+        const auto hand = cursor.read_word();
+        const auto bid = cursor.read_int<bid_value>();
         cards parsed_hand;
         std::transform(
             hand.begin(), hand.end(),
@@ -117,15 +118,6 @@ auto part2(const ElvenIO::input_type &input) {
     }
     return total_winnings;
 }
+}
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 10);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 10);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_DAY(7, 10, ELVEN_SOLVER(part1), ELVEN_SOLVER(part2))
@@ -3,6 +3,9 @@
 
 #include "elven_io.h"
 #include "elven_measure.h"
+#include "elven_runner.h"
+
+namespace {
 
 enum instruction {
     left = 0,
@@ -11,6 +14,7 @@ enum instruction {
 typedef std::string node_id;
 typedef std::array<node_id, 2> node;
 typedef std::map<node_id, node> node_maps;
+typedef std::tuple<std::vector<instruction>, std::vector<node_id>, node_maps> node_network;
 constexpr char START_MARKER = 'A';
 constexpr char END_MARKER = 'Z';
 
@@ -24,19 +28,19 @@ auto parse_instructions(const std::string &line) {
     return instructions;
 }
 
-auto parse_input(const ElvenIO::input_type &input) {
+node_network parse_input(const ElvenIO::input_type &input) {
     auto instructions = parse_instructions(input[0]);
 
     node_maps nodes;
     std::vector<node_id> start_nodes;
     for (int i = 2; i < input.size(); ++i) {
         const auto line = input[i];
-        const node_id current_node = line.substr(0, 3);
+        const node_id current_node(line.substr(0, 3));
         if (current_node.back() == START_MARKER) { start_nodes.push_back(current_node); }
-        nodes[current_node] = node{line.substr(7, 3), line.substr(12, 3)};
+        nodes[current_node] = node{node_id(line.substr(7, 3)), node_id(line.substr(12, 3))};
     }
 
-    return std::move(std::tuple(instructions, start_nodes, nodes));
+    return {std::move(instructions), std::move(start_nodes), std::move(nodes)};
 }
 
 auto solve_single(const node_id &start_node, const size_t start_steps, const std::vector<instruction> &instructions,  const node_maps &nodes) {
@@ -48,9 +52,8 @@ auto solve_single(const node_id &start_node, const size_t start_steps, const std
     return steps;
 }
 
-auto part1(const ElvenIO::input_type &input) {
-    // Join with part2 eventually.
-    const auto [instructions, _, nodes] = parse_input(input);
+auto part1(const node_network &network) {
+    const auto &[instructions, _, nodes] = network;
     size_t steps = 0;
     for (std::string current_node = "AAA"; current_node != "ZZZ"; ++steps) {
         current_node = nodes.at(current_node)[instructions[steps % instructions.size()]];
@@ -58,8 +61,8 @@ auto part1(const ElvenIO::input_type &input) {
     return steps;
 }
 
-auto part2(const ElvenIO::input_type &input) {
-    const auto [instructions, start_nodes, nodes] = parse_input(input);
+auto part2(const node_network &network) {
+    const auto &[instructions, start_nodes, nodes] = network;
     std::vector<size_t> cycles;
     std::ranges::transform(
         start_nodes.begin(), start_nodes.end(),
@@ -74,15 +77,6 @@ auto part2(const ElvenIO::input_type &input) {
         return std::lcm(a, b);
     });
 }
+}
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 10);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 10);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_PARSED_DAY(8, 10, parse_input, part1, part2)
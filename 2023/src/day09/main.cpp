@@ -1,23 +1,26 @@
-#include <sstream>
 #include <numeric>
 
 #include "elven_io.h"
 #include "elven_measure.h"
+#include "elven_parallel.h"
+#include "elven_parse.h"
+#include "elven_runner.h"
+
+namespace {
 
 typedef std::vector<long long> sequence_type;
 typedef std::vector<sequence_type> input_type;
 typedef long long solution_type;
 
-auto parse_input(const ElvenIO::input_type &input) {
+sequence_type parse_sequence(const std::string_view line) {
+    return ElvenParse::Cursor(line).read_ints<long long>();
+}
+
+input_type parse_input(const ElvenIO::input_type &input) {
     input_type sequences;
 
     for (const auto &line: input) {
-        std::stringstream stream;
-        stream << line;
-        long long value;
-        sequence_type sequence;
-        while (stream >> value) { sequence.emplace_back(value); }
-        sequences.emplace_back(sequence);
+        sequences.emplace_back(parse_sequence(line));
     }
 
     return std::move(sequences);
@@ -46,19 +49,27 @@ solution_type extrapolate_forward(const sequence_type &sequence) {
 
     return std::transform_reduce(
         differences.rbegin(), differences.rend(),
-        0,
+        static_cast<solution_type>(0),
         std::plus(),
-        [](auto sequence) { return sequence.back() ; }
+        [](const auto &sequence) { return sequence.back() ; }
     );
 }
 
-auto part1(const ElvenIO::input_type &input) {
-    const auto sequences = parse_input(input);
-    return std::transform_reduce(
+auto part1(const input_type &sequences) {
+    return ElvenParallel::transform_reduce(
         sequences.begin(), sequences.end(),
-        0,
+        static_cast<solution_type>(0),
+        std::plus(),
+        [](const auto &sequence) { return extrapolate_forward(sequence); }
+    );
+}
+
+auto part1(ElvenIO::LineStream &&input) {
+    return std::transform_reduce(
+        input.begin(), input.end(),
+        static_cast<solution_type>(0),
         std::plus(),
-        [](auto sequence) { return extrapolate_forward(sequence); }
+        [](const auto &line) { return extrapolate_forward(parse_sequence(line)); }
     );
 }
 
@@ -72,24 +83,26 @@ solution_type extrapolate_past(const sequence_type &sequence) {
     return extrapolated;
 }
 
-auto part2(const ElvenIO::input_type &input) {
-    const auto sequences = parse_input(input);
-    return std::transform_reduce(
+auto part2(const input_type &sequences) {
+    return ElvenParallel::transform_reduce(
         sequences.begin(), sequences.end(),
-        0,
+        static_cast<solution_type>(0),
+        std::plus(),
+        [](const auto &sequence) { return extrapolate_past(sequence); }
+    );
+}
+
+auto part2(ElvenIO::LineStream &&input) {
+    return std::transform_reduce(
+        input.begin(), input.end(),
+        static_cast<solution_type>(0),
         std::plus(),
-        [](auto sequence) { return extrapolate_past(sequence); }
+        [](const auto &line) { return extrapolate_past(parse_sequence(line)); }
     );
 }
+}
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 10);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 10);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_PARSED_DAY(
+    9, 10, parse_input, part1, part2,
+    ELVEN_STREAM_SOLVER(part1), ELVEN_STREAM_SOLVER(part2)
+)
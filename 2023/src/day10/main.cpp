@@ -5,6 +5,9 @@
 #include "elven_io.h"
 #include "elven_measure.h"
 #include "elven_utils.h"
+#include "elven_runner.h"
+
+namespace {
 
 typedef ElvenUtils::Point Point;
 typedef size_t Distance;
@@ -113,42 +116,7 @@ ElvenUtils::Map expand_map(const ElvenUtils::Map &map) {
 }
 
 void paint_outside_cells(ElvenUtils::Map &map) {
-    std::deque<Point> explore_cells;
-    explore_cells.emplace_back(0, 0);
-    std::set<Point> visited_cells;
-    map.set(0, 0, PAINTED_MARK);
-    while (!explore_cells.empty()) {
-        const auto point = explore_cells.front();
-        explore_cells.pop_front();
-        if (const auto north = Point(point.x, point.north());
-            map.in_y_boundary(north.y) && map.at(north) != VISITED_MARK && !visited_cells.contains(north)
-        ) {
-            explore_cells.push_back(north);
-            map.set(point.x, point.north(), PAINTED_MARK);
-            visited_cells.insert(north);
-        }
-        if (const auto south = Point(point.x, point.south());
-            map.in_y_boundary(south.y) && map.at(south) != VISITED_MARK && !visited_cells.contains(south)
-        ) {
-            explore_cells.push_back(south);
-            map.set(point.x, point.south(), PAINTED_MARK);
-            visited_cells.insert(south);
-        }
-        if (const auto east = Point(point.east(), point.y);
-            map.in_x_boundary(east.x) && map.at(east) != VISITED_MARK && !visited_cells.contains(east)
-        ) {
-            explore_cells.push_back(east);
-            map.set(point.east(), point.y, PAINTED_MARK);
-            visited_cells.insert(east);
-        }
-        if (const auto west = Point(point.west(), point.y);
-            map.in_x_boundary(west.x) && map.at(west) != VISITED_MARK && !visited_cells.contains(west)
-        ) {
-            explore_cells.push_back(west);
-            map.set(point.west(), point.y, PAINTED_MARK);
-            visited_cells.insert(west);
-        }
-    }
+    ElvenUtils::flood_fill(map, Point(0, 0), [](const char cell) { return cell != VISITED_MARK; }, PAINTED_MARK);
 }
 
 ElvenUtils::Map contract_map(const ElvenUtils::Map &map) {
@@ -177,17 +145,9 @@ size_t count_trapped_cells(const Point &start_position, const ElvenUtils::Map &m
     }
     paint_outside_cells(painted_map);
     const auto contracted_map = contract_map(painted_map);
-    return std::transform_reduce(
-        contracted_map.map.begin(), contracted_map.map.end(),
-        0,
-        std::plus(),
-        [](const auto &row) {
-            return std::count_if(row.begin(), row.end(),
-                [](const auto cell) {
-                    return cell != VISITED_MARK && cell != PAINTED_MARK;
-            });
-        }
-    );
+    // Every cell that is neither on the loop nor painted as outside is trapped.
+    return contracted_map.x_size() * contracted_map.y_size()
+           - contracted_map.count(VISITED_MARK) - contracted_map.count(PAINTED_MARK);
 }
 
 Distance farthest_loop_distance(const Point &start_position, const ElvenUtils::Map &map) {
@@ -212,15 +172,6 @@ std::size_t part2(const ElvenIO::input_type &input) {
     const auto expanded_map = expand_map(map);
     return count_trapped_cells(expanded_map.find(START_MARKER), expanded_map);
 }
+}
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 10);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 10);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_DAY(10, 10, ELVEN_SOLVER(part1), ELVEN_SOLVER(part2))
@@ -1,6 +1,9 @@
 #include "elven_io.h"
 #include "elven_measure.h"
 #include "elven_utils.h"
+#include "elven_runner.h"
+
+namespace {
 
 typedef ElvenUtils::Point Point;
 typedef ElvenUtils::Map ElfMap;
@@ -64,15 +67,6 @@ Distance part2(const ElvenIO::input_type &input) {
     expand_y(galaxies, MILLION - 1);
     return galactic_distance(galaxies);
 }
+}
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 10);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 10);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_DAY(11, 10, ELVEN_SOLVER(part1), ELVEN_SOLVER(part2))
@@ -1,11 +1,15 @@
 #include <map>
 #include <set>
-#include <sstream>
 #include <numeric>
 
 #include "elven_io.h"
 #include "elven_utils.h"
 #include "elven_measure.h"
+#include "elven_parallel.h"
+#include "elven_parse.h"
+#include "elven_runner.h"
+
+namespace {
 
 typedef std::string MapRow;
 
@@ -69,19 +73,14 @@ struct Fragment {
 typedef std::map<Fragment, std::size_t> FragmentCache;
 
 
-MapInfo parse_line(const std::string &line) {
-    std::stringstream stream;
-    stream << line;
-    std::string map_string, cluster_string_list;
-    stream >> map_string >> cluster_string_list;
-    std::stringstream cluster_stream;
-    cluster_stream << cluster_string_list;
-    std::string number_string;
+MapInfo parse_line(const std::string_view line) {
+    ElvenParse::Cursor cursor(line);
+    const auto map_string = cursor.read_word();
     Clusters clusters;
-    while(std::getline(cluster_stream, number_string, ',')) {
-        clusters.emplace_back(std::string::npos, std::string::npos, std::stol(number_string));
+    for (const auto number: ElvenParse::Split(cursor.read_word(), ',')) {
+        clusters.emplace_back(std::string::npos, std::string::npos, ElvenParse::to_int<long>(number));
     }
-    return std::move(std::make_pair(map_string, clusters));
+    return std::move(std::make_pair(std::string(map_string), clusters));
 }
 
 std::vector<ClusterData> find_damaged(const std::string_view map) {
@@ -276,15 +275,17 @@ std::size_t arrangament_count(const std::string& map, Clusters& clusters) {
     return brute_force_permutation_count(std::string_view(map), clusters, damaged_clusters, collisions, 0, 0, permutation_cache, fragment_cache);
 }
 
+// Lines are expensive and uneven, hence the small grain.
 std::size_t part1(const ElvenIO::input_type &input) {
-    return std::transform_reduce(
+    return ElvenParallel::transform_reduce(
         input.begin(), input.end(),
-        0,
+        static_cast<std::size_t>(0),
         std::plus(),
         [](const auto &line) {
             auto [map, clusters] = parse_line(line);
             return arrangament_count(map, clusters);
-        }
+        },
+        8
     );
 }
 
@@ -305,27 +306,20 @@ Clusters unfold_clusters(const Clusters& clusters) {
     return unfolded_clusters;
 }
 
-std::size_t part2(const ElvenIO::input_type &input) {
-    return std::transform_reduce(
+// Not registered, its run was commented out before the registry too.
+[[maybe_unused]] std::size_t part2(const ElvenIO::input_type &input) {
+    return ElvenParallel::transform_reduce(
         input.begin(), input.end(),
-        0,
+        static_cast<std::size_t>(0),
         std::plus(),
         [](const auto &line) {
             auto [map, clusters] = parse_line(line);
             auto unfolded_clusters = unfold_clusters(clusters);
             return arrangament_count(unfold_map(map), unfolded_clusters);
-        }
+        },
+        8
     );
 }
+}
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 10);
-    reporter.add_report(1, result1, solution1_time);
-    //auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 10);
-    //reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_DAY(12, 10, ELVEN_SOLVER(part1) /*, ELVEN_SOLVER(part2) */)
@@ -2,11 +2,15 @@
 
 #include "elven_io.h"
 #include "elven_measure.h"
+#include "elven_parallel.h"
 #include "elven_utils.h"
+#include "elven_runner.h"
+
+namespace {
 
 typedef ElvenUtils::Map Map;
 
-auto parse_input(const ElvenIO::input_type &input) {
+std::vector<Map> parse_input(const ElvenIO::input_type &input) {
     std::vector<Map> maps;
     std::vector<std::string> map;
     for (const auto& line : input) {
@@ -59,34 +63,25 @@ std::size_t mirror_score(const Map &map, const int smudges) {
     throw std::runtime_error("no reflection found");
 }
 
-std::size_t part1(const ElvenIO::input_type &input) {
-    const auto maps = parse_input(input);
-    return std::transform_reduce(
+std::size_t part1(const std::vector<Map> &maps) {
+    return ElvenParallel::transform_reduce(
         maps.begin(), maps.end(),
         static_cast<size_t>(0),
         std::plus(),
-        [](const auto &map) { return mirror_score(map, 0); }
+        [](const auto &map) { return mirror_score(map, 0); },
+        32
     );
 }
 
-std::size_t part2(const ElvenIO::input_type &input) {
-    const auto maps = parse_input(input);
-    return std::transform_reduce(
+std::size_t part2(const std::vector<Map> &maps) {
+    return ElvenParallel::transform_reduce(
         maps.begin(), maps.end(),
         static_cast<size_t>(0),
         std::plus(),
-        [](const auto &map) { return mirror_score(map, 1); }
+        [](const auto &map) { return mirror_score(map, 1); },
+        32
     );
 }
+}
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 10);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 10);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_PARSED_DAY(13, 10, parse_input, part1, part2)
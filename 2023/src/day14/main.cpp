@@ -2,6 +2,9 @@
 #include "elven_io.h"
 #include "elven_measure.h"
 #include "elven_utils.h"
+#include "elven_runner.h"
+
+namespace {
 
 typedef ElvenUtils::Map Map;
 typedef ElvenUtils::Point Point;
@@ -107,15 +110,6 @@ std::size_t part2(const ElvenIO::input_type &input) {
     for (;states[tortoise] != states[hare]; ++hare, ++lam) { }
     return total_load(map, states[mu + (1000000000 - mu) % lam]);
 }
+}
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 10);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 10);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_DAY(14, 10, ELVEN_SOLVER(part1), ELVEN_SOLVER(part2))
@@ -1,27 +1,29 @@
-#include <sstream>
 #include <numeric>
 
 #include "elven_io.h"
 #include "elven_measure.h"
+#include "elven_parallel.h"
+#include "elven_parse.h"
+#include "elven_utils.h"
+#include "elven_runner.h"
 
 
-typedef std::vector<std::string> Sequences;
-typedef std::array<std::vector<std::string>, 256> Boxes;
+namespace {
+
+// Sequences are views into the input, parsed once for both parts, the boxes and their lenses live in an
+// ElvenUtils::Arena for the part.
+typedef std::vector<std::string_view> Sequences;
+typedef std::pmr::vector<std::pmr::vector<std::pmr::string>> Boxes;
 
 constexpr char REMOVE_TOKEN = '-';
+constexpr std::size_t BOX_COUNT = 256;
 
 Sequences parse_input(const ElvenIO::input_type &input) {
-    Sequences sequences;
-    std::stringstream stream;
-    stream << input[0];
-    std::string sequence;
-    while(std::getline(stream, sequence, ',')) {
-        sequences.emplace_back(sequence);
-    }
-    return std::move(sequences);
+    const ElvenParse::Split split(input[0], ',');
+    return {split.begin(), split.end()};
 }
 
-std::size_t elf_hash(const std::string &sequence) {
+std::size_t elf_hash(const std::string_view sequence) {
     std::size_t hash = 0;
     for (const auto &c: sequence) {
         hash = (hash + c) * 17 % 256;
@@ -29,30 +31,32 @@ std::size_t elf_hash(const std::string &sequence) {
     return hash;
 }
 
-std::size_t part1(const ElvenIO::input_type &input) {
-    const auto sequences = parse_input(input);
-    return std::transform_reduce(
+std::size_t part1(const Sequences &sequences) {
+    return ElvenParallel::transform_reduce(
         sequences.begin(), sequences.end(),
-        0,
+        static_cast<std::size_t>(0),
         std::plus(),
         [](const auto &sequence) { return elf_hash(sequence); }
     );
 }
 
+// Whether `lens` ("label=N") carries `label`.
+bool has_label(const std::string_view lens, const std::string_view label) {
+    return lens.size() > label.size() && lens.starts_with(label) && lens[label.size()] == '=';
+}
+
 void execute_sequences(const Sequences &sequences, Boxes &boxes) {
     for (const auto &sequence: sequences) {
         if (sequence.back() == REMOVE_TOKEN) {
-            std::string label = sequence.substr(0, sequence.size() -1);
+            const auto label = sequence.substr(0, sequence.size() -1);
             auto &box = boxes[elf_hash(label)];
-            std::string comp_label = label + "=";
-            std::erase_if(box, [&comp_label](const auto &elem) { return elem.starts_with(comp_label); });
+            std::erase_if(box, [&label](const auto &elem) { return has_label(elem, label); });
         } else {
-            std::string label = sequence.substr(0, sequence.size() -2);
+            const auto label = sequence.substr(0, sequence.size() -2);
             auto &box = boxes[elf_hash(label)];
-            std::string comp_label = label + "=";
-            auto found = std::ranges::find_if(box.begin(), box.end(), [&comp_label](const auto &elem) { return elem.starts_with(comp_label); });
+            auto found = std::ranges::find_if(box.begin(), box.end(), [&label](const auto &elem) { return has_label(elem, label); });
             if (found == box.end()) {
-                box.push_back(sequence);
+                box.emplace_back(sequence);
             } else {
                 *found = sequence;
             }
@@ -72,21 +76,12 @@ std::size_t focusing_power(const Boxes &boxes) {
     return power;
 }
 
-std::size_t part2(const ElvenIO::input_type &input) {
-    const auto sequences = parse_input(input);
-    Boxes boxes;
+std::size_t part2(const Sequences &sequences) {
+    ElvenUtils::Arena arena;
+    Boxes boxes(BOX_COUNT, arena.resource());
     execute_sequences(sequences, boxes);
     return focusing_power(boxes);
 }
+}
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 10);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 10);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_PARSED_DAY(15, 10, parse_input, part1, part2)
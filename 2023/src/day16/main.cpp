@@ -1,17 +1,19 @@
 
+#include <array>
 #include <deque>
-#include <set>
 
 #include "elven_io.h"
 #include "elven_utils.h"
 #include "elven_measure.h"
+#include "elven_runner.h"
+
+namespace {
 
 typedef ElvenUtils::Map Map;
 typedef ElvenUtils::Point Point;
 typedef std::pair<Point, Point> Beam;
 
 constexpr char EMPTY = ElvenUtils::Map::EMPTY;
-constexpr char ENERGIZED = ElvenUtils::Map::BLOCKED;
 constexpr char RIGHT_UP_MIRROR = '/';
 constexpr char RIGHT_DOWN_MIRROR = '\\';
 constexpr char VERTICAL_SPLITTER = '|';
@@ -63,18 +65,25 @@ void queue_new_position(const Map &map, const Point &beam_position, const Point
     }
 }
 
-Map energize(const Map &map, const Point &start_position, const Point &start_direction) {
-    Map energized(map);
+std::size_t direction_index(const Point &direction) {
+    if (direction == RIGHT_DIRECTION) { return 0; }
+    if (direction == LEFT_DIRECTION) { return 1; }
+    if (direction == UP_DIRECTION) { return 2; }
+    return 3;
+}
+
+// A beam state is visited once per direction it enters a cell with, so one bit grid per direction replaces the set.
+ElvenUtils::BitGrid energize(const Map &map, const Point &start_position, const Point &start_direction) {
+    ElvenUtils::BitGrid energized(map.x_size(), map.y_size());
+    std::array visited_states{energized, energized, energized, energized};
     std::deque<Beam> beams;
-    std::set<Beam> visited_states;
     beams.emplace_back(start_position, start_direction);
     while (!beams.empty()) {
         auto [beam_position, beam_direction] = beams.front();
         beams.pop_front();
-        auto [_, has_been_inserted] = visited_states.insert(Beam(beam_position, beam_direction));
         beam_position += beam_direction;
-        if (has_been_inserted && map.in_boundary(beam_position)) {
-            energized.set(beam_position, ENERGIZED);
+        if (map.in_boundary(beam_position) && !visited_states[direction_index(beam_direction)].test_and_set(beam_position)) {
+            energized.set(beam_position);
             queue_new_position(map, beam_position, beam_direction, beams);
         }
     }
@@ -84,31 +93,22 @@ Map energize(const Map &map, const Point &start_position, const Point &start_dir
 
 std::size_t part1(const ElvenIO::input_type &input) {
     const Map map(input);
-    return energize(map, Point(-1, 0), RIGHT_DIRECTION).find_all(ENERGIZED).size();
+    return energize(map, Point(-1, 0), RIGHT_DIRECTION).count();
 }
 
 std::size_t part2(const ElvenIO::input_type &input) {
     std::size_t count = 0;
     const Map map(input);
     for (int i = 0; i < map.x_size(); ++i) {
-        count = std::max(count, energize(map, Point(i, -1), DOWN_DIRECTION).find_all(ENERGIZED).size());
-        count = std::max(count,energize(map, Point(i, map.y_size()), UP_DIRECTION).find_all(ENERGIZED).size());
+        count = std::max(count, energize(map, Point(i, -1), DOWN_DIRECTION).count());
+        count = std::max(count,energize(map, Point(i, map.y_size()), UP_DIRECTION).count());
     }
     for (int i = 0; i < map.y_size(); ++i) {
-        count = std::max(count, energize(map, Point(-1, i), RIGHT_DIRECTION).find_all(ENERGIZED).size());
-        count = std::max(count,energize(map, Point(map.x_size(), i), LEFT_DIRECTION).find_all(ENERGIZED).size());
+        count = std::max(count, energize(map, Point(-1, i), RIGHT_DIRECTION).count());
+        count = std::max(count,energize(map, Point(map.x_size(), i), LEFT_DIRECTION).count());
     }
     return count;
 }
+}
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 10);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 10);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_DAY(16, 10, ELVEN_SOLVER(part1), ELVEN_SOLVER(part2))
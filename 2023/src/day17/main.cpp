@@ -4,6 +4,9 @@
 #include "elven_io.h"
 #include "elven_utils.h"
 #include "elven_measure.h"
+#include "elven_runner.h"
+
+namespace {
 
 typedef ElvenUtils::Map Map;
 typedef ElvenUtils::Point Point;
@@ -51,7 +54,7 @@ struct VisistedStates {
         std::vector<std::vector<std::size_t>> up_locked;
         std::vector<std::vector<std::size_t>> left_locked;
         std::vector<std::vector<std::size_t>> right_locked;
-        for (const auto & row : map.map) {
+        for (std::size_t y = 0; y < map.y_size(); ++y) {
             std::vector heat_row(map.x_size(), std::numeric_limits<size_t>::max());
             down_locked.emplace_back(heat_row);
             up_locked.emplace_back(heat_row);
@@ -148,8 +151,8 @@ std::size_t min_heat_loss(const Map& map, const int num_moves, const int can_tur
 
 std::size_t part1(const ElvenIO::input_type& input) {
     Map map(input);
-    for (auto &row : map.map) {
-        for (auto &cell : row) {
+    for (ElvenUtils::Y y = 0; y < map.y_size(); ++y) {
+        for (auto &cell : map.row(y)) {
             cell -= '0';
         }
     }
@@ -158,22 +161,13 @@ std::size_t part1(const ElvenIO::input_type& input) {
 
 std::size_t part2(const ElvenIO::input_type& input) {
     Map map(input);
-    for (auto &row : map.map) {
-        for (auto &cell : row) {
+    for (ElvenUtils::Y y = 0; y < map.y_size(); ++y) {
+        for (auto &cell : map.row(y)) {
             cell -= '0';
         }
     }
     return min_heat_loss(map, ULTRA_NUM_MOVES, ULTRA_CAN_TURN_AT_REMAINING_MOVES);
 }
+}
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 1);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 1);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_DAY(17, 1, ELVEN_SOLVER(part1), ELVEN_SOLVER(part2))
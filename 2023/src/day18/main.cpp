@@ -1,9 +1,12 @@
-#include <sstream>
 #include <__numeric/transform_reduce.h>
 
 #include "elven_io.h"
 #include "elven_utils.h"
 #include "elven_measure.h"
+#include "elven_parse.h"
+#include "elven_runner.h"
+
+namespace {
 
 typedef ElvenUtils::Map Map;
 typedef ElvenUtils::Point Point;
@@ -17,32 +20,29 @@ constexpr char TRENCH = ElvenUtils::Map::BLOCKED;
 constexpr char PAINTED = 'X';
 
 
-auto parse_line(const std::string& line) {
-    std::stringstream stream;
-    stream << line;
-    char direction;
-    int count;
-    std::string color;
-    stream >> direction >> count >> color;
-    return std::make_tuple(direction, count);
+auto parse_line(const std::string_view line) {
+    ElvenParse::Cursor cursor(line);
+    const auto direction = cursor.read_word()[0];
+    return std::make_tuple(direction, cursor.read_int<int>());
 }
 
-void execute(const char direction, const int count, std::vector<Point>& path, ElvenUtils::Point& position) {
+void advance(const char direction, const long count, ElvenUtils::Point& position) {
     if (direction == UP) {
         position.y -= count;
-        path.push_back(position);
     } else if (direction == DOWN) {
         position.y += count;
-        path.push_back(position);
     } else if (direction == RIGHT) {
         position.x += count;
-        path.push_back(position);
     } else if (direction == LEFT) {
         position.x -= count;
-        path.push_back(position);
     }
 }
 
+void execute(const char direction, const int count, std::vector<Point>& path, ElvenUtils::Point& position) {
+    advance(direction, count, position);
+    path.push_back(position);
+}
+
 // https://rosettacode.org/wiki/Shoelace_formula_for_polygonal_area
 // https://en.wikipedia.org/wiki/Pick%27s_theorem
 std::size_t shoelace_and_picks(const std::vector<Point>& path) {
@@ -55,6 +55,24 @@ std::size_t shoelace_and_picks(const std::vector<Point>& path) {
     return std::abs(area) / 2 + perifery  / 2 + 1;
 }
 
+// shoelace_and_picks accumulated one instruction at a time, so the path never needs to be stored.
+struct Lagoon {
+    Point position = Point(0, 0);
+    long long area = 0;
+    long long perifery = 0;
+
+    void dig(const char direction, const long count) {
+        const auto previous = position;
+        advance(direction, count, position);
+        area += previous.x * position.y - position.x * previous.y;
+        perifery += count;
+    }
+
+    [[nodiscard]] std::size_t size() const {
+        return std::abs(area) / 2 + perifery / 2 + 1;
+    }
+};
+
 std::size_t part1(const ElvenIO::input_type &input) {
     auto position = Point(0, 0);
     std::vector<Point> path;
@@ -66,12 +84,17 @@ std::size_t part1(const ElvenIO::input_type &input) {
     return shoelace_and_picks(path);
 }
 
-auto hex_to_int(const std::string& hex_string) {
-    unsigned long parsed_value;
-    std::stringstream stream;
-    stream << std::hex << hex_string;
-    stream >> parsed_value;
-    return parsed_value;
+std::size_t part1(ElvenIO::LineStream &&input) {
+    Lagoon lagoon;
+    for(const auto &line: input) {
+        auto [direction, count] = parse_line(line);
+        lagoon.dig(direction, count);
+    }
+    return lagoon.size();
+}
+
+auto hex_to_int(const std::string_view hex_string) {
+    return ElvenParse::to_int<unsigned long>(hex_string, 16);
 }
 
 auto digit_to_direction(const char digit) {
@@ -81,13 +104,11 @@ auto digit_to_direction(const char digit) {
     if (digit == '3') { return UP; }
 }
 
-auto parse_color_line(const std::string& line) {
-    std::stringstream stream;
-    stream << line;
-    char fake_direction;
-    int fake_count;
-    std::string color;
-    stream >> fake_direction >> fake_count >> color;
+auto parse_color_line(const std::string_view line) {
+    ElvenParse::Cursor cursor(line);
+    cursor.read_word();
+    cursor.read_word();
+    const auto color = cursor.read_word();
     return std::make_tuple(digit_to_direction(color[color.size() -2]), hex_to_int(color.substr(2, color.size() -4)));
 }
 
@@ -102,14 +123,18 @@ std::size_t part2(const ElvenIO::input_type &input) {
     return shoelace_and_picks(path);
 }
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 100);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 100);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+std::size_t part2(ElvenIO::LineStream &&input) {
+    Lagoon lagoon;
+    for(const auto &line: input) {
+        auto [direction, count] = parse_color_line(line);
+        lagoon.dig(direction, count);
+    }
+    return lagoon.size();
+}
+}
+
+ELVEN_DAY(
+    18, 100,
+    ELVEN_SOLVER(part1), ELVEN_SOLVER(part2),
+    ELVEN_STREAM_SOLVER(part1), ELVEN_STREAM_SOLVER(part2)
+)
@@ -1,16 +1,21 @@
 #include <map>
-#include <sstream>
+#include <memory>
 #include <__numeric/transform_reduce.h>
 
 #include "elven_io.h"
 #include "elven_utils.h"
 #include "elven_measure.h"
+#include "elven_parse.h"
+#include "elven_runner.h"
+
+namespace {
 
 const std::string ACCEPTED = "A";
 const std::string REJECTED = "R";
 
-typedef std::map<char, size_t> PartSet;
-typedef std::vector<PartSet> PartSets;
+// Parts live in an ElvenUtils::Arena owned by the parsed model.
+typedef std::pmr::map<char, size_t> PartSet;
+typedef std::pmr::vector<PartSet> PartSets;
 
 struct Condition {
     Condition(const char label, const char sign, const std::size_t value, const std::string& next_stage)
@@ -54,54 +59,59 @@ struct Workflow {
 
 typedef std::map<std::string, Workflow> Workflows;
 
-auto parse_workflow(const std::string& description) {
-    std::stringstream stream;
-    stream << description;
-    std::string condition;
-    std::vector<std::string> raw_conditions;
-    while (std::getline(stream, condition, ',')) {
-        raw_conditions.push_back(condition);
-    }
+// The arena is declared first so it outlives the part sets allocated from it, and is held by pointer so moving the
+// model leaves their memory resource in place.
+struct System {
+    std::unique_ptr<ElvenUtils::Arena> arena;
+    Workflows workflows;
+    PartSets part_sets;
+};
+
+auto parse_workflow(const std::string_view description) {
+    const std::vector<std::string_view> raw_conditions(
+        ElvenParse::Split(description, ',').begin(), ElvenParse::Split(description, ',').end()
+    );
     std::vector<Condition> conditions;
     for (int i = 0; i < raw_conditions.size() - 1; ++i) {
-        auto raw_condition = raw_conditions[i];
+        const auto raw_condition = raw_conditions[i];
         auto label = raw_condition[0];
         auto operation = raw_condition[1];
         auto colon_pos = raw_condition.find(':');
-        auto next_stage = raw_condition.substr(colon_pos + 1);
-        auto tmp = raw_condition.substr(2, colon_pos - 2);
-        auto value = std::stol(raw_condition.substr(2, colon_pos - 2));
+        auto next_stage = std::string(raw_condition.substr(colon_pos + 1));
+        auto value = ElvenParse::to_int<std::size_t>(raw_condition.substr(2, colon_pos - 2));
         conditions.emplace_back(label, operation, value, next_stage);
     }
-    return Workflow(raw_conditions.back(), conditions);
+    return Workflow(std::string(raw_conditions.back()), conditions);
 }
 
-auto parse_input(const ElvenIO::input_type &input) {
+// Arena bytes per part: its PartSet in the vector and a tree node per rating, the rating plus about four pointers of
+// node header. The first block then holds every part, and the arena only grows past it where the estimate is short.
+constexpr std::size_t RATINGS = 4;
+constexpr std::size_t PART_BYTES = sizeof(PartSet) + RATINGS * (sizeof(PartSet::value_type) + 4 * sizeof(void *));
+
+System parse_input(const ElvenIO::input_type &input) {
     Workflows workflows;
     int i = 0;
     for(; input[i] != ""; ++i) {
-        std::stringstream stream;
-        stream << input[i];
-        std::string label;
-        std::string description;
-        std::getline(stream, label, '{');
-        std::getline(stream, description, '}');
-        workflows.emplace(label, parse_workflow(description));
+        ElvenParse::Cursor cursor(input[i]);
+        const auto label = cursor.read_until('{');
+        workflows.emplace(label, parse_workflow(cursor.read_until('}')));
     }
 
-    PartSets part_sets;
+    const auto part_count = input.size() - i - 1;
+    auto arena = std::make_unique<ElvenUtils::Arena>(part_count * PART_BYTES);
+    std::pmr::memory_resource *memory = arena->resource();
+    PartSets part_sets(memory);
+    part_sets.reserve(part_count);
     for (i = i + 1; i < input.size(); ++i) {
-        std::stringstream stream;
-        stream << input[i].substr(1, input[i].size() - 2);
-        std::string piece;
-        PartSet part_set;
-        while (std::getline(stream, piece, ',')) {
-            part_set[piece[0]] = std::stol(piece.substr(2));
+        PartSet part_set(memory);
+        for (const auto piece: ElvenParse::Split(input[i].substr(1, input[i].size() - 2), ',')) {
+            part_set[piece[0]] = ElvenParse::to_int<size_t>(piece.substr(2));
         }
-        part_sets.emplace_back(part_set);
+        part_sets.push_back(std::move(part_set));
     }
 
-    return std::make_tuple(workflows, part_sets);
+    return {std::move(arena), std::move(workflows), std::move(part_sets)};
 }
 
 bool processed_successfully(const PartSet& part_set, const Workflows& workflows) {
@@ -112,11 +122,10 @@ bool processed_successfully(const PartSet& part_set, const Workflows& workflows)
     return current_state == ACCEPTED;
 }
 
-std::size_t part1(const ElvenIO::input_type &input) {
-    auto [workflows, part_sets] = parse_input(input);
+std::size_t part1(const System &system) {
     std::size_t result = 0;
-    for (const auto& part_set: part_sets) {
-        if (processed_successfully(part_set, workflows)) {
+    for (const auto& part_set: system.part_sets) {
+        if (processed_successfully(part_set, system.workflows)) {
             for (auto [label, value] : part_set) {
                 result += value;
             }
@@ -178,8 +187,8 @@ std::size_t explore_workflows(const Workflows& workflows, const Workflow& workfl
     return result;
 }
 
-std::size_t part2(const ElvenIO::input_type &input) {
-    auto [workflows, _] = parse_input(input);
+std::size_t part2(const System &system) {
+    const auto &workflows = system.workflows;
     AllowedValues allowed_values;
     allowed_values.emplace('x', Range());
     allowed_values.emplace('m', Range());
@@ -187,15 +196,6 @@ std::size_t part2(const ElvenIO::input_type &input) {
     allowed_values.emplace('s', Range());
     return explore_workflows(workflows, workflows.at("in"), allowed_values);
 }
+}
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 100);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 100);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_PARSED_DAY(19, 100, parse_input, part1, part2)
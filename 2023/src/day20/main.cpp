@@ -1,57 +1,31 @@
-#include <sstream>
 #include <map>
 #include <numeric>
 
 #include "elven_io.h"
 #include "elven_utils.h"
 #include "elven_measure.h"
+#include "elven_parse.h"
+#include "elven_runner.h"
+
+namespace {
 
 const std::string BROADCASTER_ID = "broadcaster";
-const std::string BUTTON_ID = "button";
 const std::string RX_ID = "rx";
 
 enum Pulse { low, high };
 enum ModuleKind { flipflop, conjunction, broadcaster, rx};
-struct PulseCommand {
-    std::string from;
-    std::string to;
-    Pulse pulse;
-};
 
 class Module {
-    std::map<std::string, uint8_t> in;
-    bool state;
-
 public:
     std::string id;
     ModuleKind kind;
+    std::vector<std::string> in;
     std::vector<std::string> out;
 
     Module(const std::string& id, ModuleKind kind) : id(id), kind(kind) {}
 
     void register_out(const std::string& id) { out.emplace_back(id); }
-    void register_in(const std::string& id) { in.emplace(id, low); }
-
-    void trigger(const std::string& from, const Pulse& pulse, std::deque<PulseCommand> &pulses) {
-        if (kind == flipflop) {
-            if (pulse == low) {
-                state = !state;
-                for (const auto& module : out) {
-                    pulses.push_back({id, module, state ? high : low});
-                }
-            }
-        } else if (kind == conjunction) {
-            in[from] = pulse;
-            const auto are_all_high = std::ranges::all_of(in.begin(), in.end(), [](const auto& entry) { return entry.second == high; });
-            for (const auto& module : out) {
-                pulses.push_back({id, module, are_all_high ? low : high});
-            }
-        } else if (kind == broadcaster) {
-            for (const auto &module : out) {
-                pulses.push_back({id, module, low});
-            }
-        }
-    }
+    void register_in(const std::string& id) { in.emplace_back(id); }
 
     void print_as_simple_mermaid() const {
         for (const auto& out_id : out) {
@@ -64,26 +38,23 @@ public:
     }
 };
 
-std::vector<std::string> parse_out(const std::string& line) {
+std::vector<std::string> parse_out(const std::string_view line) {
     std::vector<std::string> out;
-    std::stringstream stream;
-    stream << line;
-    std::string out_label;
-    while (getline(stream, out_label, ',')) {
-        out.push_back(out_label.substr(1));
+    for (const auto out_label: ElvenParse::Split(line, ',')) {
+        out.emplace_back(out_label.substr(1));
     }
     return std::move(out);
 }
 
-std::string parse_id(const std::string& line) {
+std::string parse_id(const std::string_view line) {
     const auto separator_pos = line.find('-');
     if (line.starts_with('%') || line.starts_with('&')) {
-        return std::move(line.substr(1, separator_pos - 2));
+        return std::string(line.substr(1, separator_pos - 2));
     }
-    return std::move(line.substr(0, separator_pos - 1));
+    return std::string(line.substr(0, separator_pos - 1));
 }
 
-ModuleKind parse_kind(const std::string& line) {
+ModuleKind parse_kind(const std::string_view line) {
     if (line.starts_with('%')) {
         return flipflop;
     }
@@ -113,26 +84,106 @@ std::map<std::string, Module> parse_input(const ElvenIO::input_type &input) {
     return modules;
 }
 
-std::size_t part1(const ElvenIO::input_type &input) {
-    auto modules = parse_input(input);
-    auto broadcaster = modules.at(BROADCASTER_ID);
-    std::size_t low_pulses = 0;
-    std::size_t high_pulses = 0;
-
+// The parsed modules flattened for simulation, with the modules numbered in map order. The graph is read only once;
+// the state pressing the button changes lives in flat vectors: one flip-flop state per module, and one remembered
+// pulse per conjunction input together with how many of a conjunction's inputs are high.
+class PulseNetwork {
+    struct Edge {
+        std::size_t to;
+        std::size_t slot;
+    };
+
+    struct PulseCommand {
+        Edge edge;
+        Pulse pulse;
+    };
+
+    struct Node {
+        ModuleKind kind;
+        std::size_t inputs;
+        std::vector<Edge> out;
+    };
+
+    std::vector<Node> nodes;
+    std::size_t broadcaster_id = 0;
+    std::vector<uint8_t> flipflop_states;
+    std::vector<Pulse> input_pulses;
+    std::vector<std::size_t> high_inputs;
     std::deque<PulseCommand> pulses;
-    for (int i = 0; i < 1000; ++i) {
-        pulses.push_back({BUTTON_ID, BROADCASTER_ID, low});
+
+    void send(const std::size_t from, const Pulse pulse) {
+        for (const auto &edge : nodes[from].out) {
+            pulses.push_back({edge, pulse});
+        }
+    }
+
+    void trigger(const PulseCommand &command) {
+        const auto id = command.edge.to;
+        const auto &node = nodes[id];
+        if (node.kind == flipflop) {
+            if (command.pulse == low) {
+                flipflop_states[id] = !flipflop_states[id];
+                send(id, flipflop_states[id] ? high : low);
+            }
+        } else if (node.kind == conjunction) {
+            auto &remembered = input_pulses[command.edge.slot];
+            if (remembered != command.pulse) {
+                command.pulse == high ? ++high_inputs[id] : --high_inputs[id];
+                remembered = command.pulse;
+            }
+            send(id, high_inputs[id] == node.inputs ? low : high);
+        } else if (node.kind == broadcaster) {
+            send(id, low);
+        }
+    }
+
+public:
+    explicit PulseNetwork(const std::map<std::string, Module> &modules) {
+        std::map<std::string_view, std::size_t> ids;
+        std::vector<std::size_t> first_slots;
+        std::size_t slots = 0;
+        for (const auto &[id, module] : modules) {
+            ids.emplace(id, nodes.size());
+            nodes.push_back({module.kind, module.in.size(), {}});
+            first_slots.push_back(slots);
+            slots += module.in.size();
+        }
+        for (const auto &[id, module] : modules) {
+            auto &node = nodes[ids.at(id)];
+            for (const auto &out_id : module.out) {
+                const auto to = ids.at(out_id);
+                node.out.push_back({to, first_slots[to]++});
+            }
+        }
+        broadcaster_id = ids.at(BROADCASTER_ID);
+        flipflop_states.assign(nodes.size(), false);
+        input_pulses.assign(slots, low);
+        high_inputs.assign(nodes.size(), 0);
+    }
+
+    // Presses the button once and adds the low and high pulses sent, the button's own included.
+    void press(std::size_t &low_pulses, std::size_t &high_pulses) {
+        pulses.push_back({{broadcaster_id, 0}, low});
         while (!pulses.empty()) {
-            auto pulse = pulses.front();
+            const auto command = pulses.front();
             pulses.pop_front();
-            if (pulse.pulse == low) {
+            if (command.pulse == low) {
                 ++low_pulses;
             } else {
                 ++high_pulses;
             }
-            modules.at(pulse.to).trigger(pulse.from, pulse.pulse, pulses);
+            trigger(command);
         }
     }
+};
+
+std::size_t part1(const std::map<std::string, Module> &modules) {
+    PulseNetwork network(modules);
+    std::size_t low_pulses = 0;
+    std::size_t high_pulses = 0;
+    for (int i = 0; i < 1000; ++i) {
+        network.press(low_pulses, high_pulses);
+    }
     return low_pulses * high_pulses;
 }
 
@@ -161,8 +212,7 @@ long fliflop_path_decode(const std::string &start, const std::map<std::string, M
     return decoded_value;
 }
 
-std::size_t part2(const ElvenIO::input_type &input) {
-    const auto modules = parse_input(input);
+std::size_t part2(const std::map<std::string, Module> &modules) {
     const auto& broadcaster = modules.at(BROADCASTER_ID);
     std::vector<long> flipflop_paths;
     flipflop_paths.reserve(broadcaster.out.size());
@@ -176,15 +226,6 @@ std::size_t part2(const ElvenIO::input_type &input) {
         return std::lcm(a, b);
     });
 }
+}
 
-int main(int _, char** argv) {
-    ElvenMeasure::Reporter reporter;
-    const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read(argv[1]); });
-    reporter.add_io_report(io_time);
-    auto [result1, solution1_time] = ElvenMeasure::execute([=] { return part1(input); }, 100);
-    reporter.add_report(1, result1, solution1_time);
-    auto [result2, solution2_time] = ElvenMeasure::execute([=] { return part2(input); }, 100);
-    reporter.add_report(2, result2, solution2_time);
-    reporter.report();
-    return 0;
-}
\ No newline at end of file
+ELVEN_PARSED_DAY(20, 100, parse_input, part1, part2)
@@ -0,0 +1,220 @@
+// Runs any subset of the registered days in one process, so process startup and the dynamic loader stay out of the
+// measurements:
+//   elven_runner [--data=data] [--jobs=N] [--report=text|json|csv] [--sweep=1,2,4,...] [day|first-last]...
+// Every day's I/O is one task, its parse (for days that share a parsed model between parts) another and each of its
+// parts another task, each queued once the one before is done, all scheduled on a work-stealing pool of N workers (all
+// cores by default). ElvenParallel gets the cores the workers leave, so the two pools never oversubscribe the machine:
+// all of them with --jobs=1, which also keeps parts from sharing the caches with each other. Allocation tracking and
+// perf counters measure the whole process and always run with --jobs=1. A failing task is reported on stderr, the
+// other days still run and the exit status is 1.
+// --sweep instead runs the days one at a time once per data-parallel thread count (ElvenParallel) and prints each
+// part's speedup curve.
+
+#include <iomanip>
+#include <sstream>
+
+#include "elven_parallel.h"
+#include "elven_runner.h"
+
+// Everything one day's tasks produce. Each task writes only its own fields, the report is printed after the pool is
+// drained.
+struct DayRun {
+    const ElvenRunner::Day *day = nullptr;
+    std::string path;
+    ElvenIO::input_type input;
+    ElvenMeasure::Time io_time{};
+    ElvenRunner::Model model;
+    std::optional<ElvenMeasure::Timing> parse_timing;
+    std::array<std::optional<std::pair<std::size_t, ElvenMeasure::Timing>>, 2> parts;
+    // Worker of the I/O task, the parse task, then of each part task, and what the task threw if it failed.
+    std::array<std::size_t, 4> workers{};
+    std::array<std::optional<std::string>, 4> failures;
+
+    DayRun(const ElvenRunner::Day *day, std::string path) : day(day), path(std::move(path)) {}
+};
+
+std::string input_path(const std::string &data_directory, const int day) {
+    std::ostringstream path;
+    path << data_directory << "/day" << std::setw(2) << std::setfill('0') << day << "/input.txt";
+    return path.str();
+}
+
+constexpr std::array<std::string_view, 4> TASK_NAMES{"I/O", "Parse", "Part1", "Part2"};
+
+// Runs task `task` of `run`, recording the worker it ran on. A failure is kept for the report instead of draining the
+// pool, so the other days still run, and the tasks that depend on this one are not scheduled.
+template<class F>
+bool run_task(DayRun &run, const std::size_t task, const F &f) {
+    run.workers[task] = ElvenParallel::ThreadPool::worker_index();
+    try {
+        f();
+        return true;
+    } catch (const std::exception &exception) {
+        run.failures[task] = exception.what();
+        return false;
+    }
+}
+
+void schedule_parts(ElvenParallel::ThreadPool &pool, DayRun &run) {
+    for (std::size_t i = 0; i < 2; ++i) {
+        if (run.day->parts()[i] == nullptr) { continue; }
+        pool.submit([&run, i] {
+            run_task(run, i + 2, [&run, i] {
+                run.parts[i] = ElvenRunner::run_part(*run.day, i, run.input, run.model);
+            });
+        });
+    }
+}
+
+void schedule(ElvenParallel::ThreadPool &pool, DayRun &run) {
+    pool.submit([&pool, &run] {
+        const bool read = run_task(run, 0, [&run] {
+            auto [input, io_time] = ElvenMeasure::execute([&run] { return ElvenIO::read_mapped(run.path.c_str()); });
+            run.input = std::move(input);
+            run.io_time = io_time;
+        });
+        if (!read) { return; }
+        if (run.day->parse == nullptr) {
+            schedule_parts(pool, run);
+            return;
+        }
+        pool.submit([&pool, &run] {
+            const bool parsed = run_task(run, 1, [&run] {
+                auto [model, timing] = *ElvenRunner::run_parse(*run.day, run.input);
+                run.model = std::move(model);
+                run.parse_timing = std::move(timing);
+            });
+            if (parsed) { schedule_parts(pool, run); }
+        });
+    });
+}
+
+// Mean of each part's solve at every thread count, with the speedup over the first count. Inputs are parsed once.
+void sweep(std::vector<DayRun> &runs, const std::vector<std::size_t> &thread_counts) {
+    for (auto &run: runs) {
+        run.input = ElvenIO::read_mapped(run.path.c_str());
+        if (auto parsed = ElvenRunner::run_parse(*run.day, run.input)) { run.model = std::move(parsed->first); }
+    }
+
+    std::vector<std::array<std::vector<ElvenMeasure::Time>, 2>> means(runs.size());
+    for (const auto threads: thread_counts) {
+        ElvenParallel::set_thread_count(threads);
+        for (std::size_t day = 0; day < runs.size(); ++day) {
+            for (std::size_t i = 0; i < 2; ++i) {
+                if (const auto part = ElvenRunner::run_part(*runs[day].day, i, runs[day].input, runs[day].model)) {
+                    means[day][i].push_back(part->second.mean());
+                }
+            }
+        }
+    }
+
+    for (std::size_t day = 0; day < runs.size(); ++day) {
+        for (std::size_t i = 0; i < 2; ++i) {
+            if (means[day][i].empty()) { continue; }
+            const auto &curve = means[day][i];
+            std::cout << "Day " << runs[day].day->number << " Part" << i + 1 << " :";
+            for (std::size_t j = 0; j < curve.size(); ++j) {
+                const auto speedup = static_cast<double>(curve[0].count()) / std::max<long long>(curve[j].count(), 1);
+                std::cout << (j == 0 ? " " : ", ") << thread_counts[j] << " threads " << ElvenMeasure::cast_time(curve[j])
+                          << " (x" << std::fixed << std::setprecision(2) << speedup << ")";
+            }
+            std::cout << std::endl;
+        }
+    }
+}
+
+int main(const int argc, char** argv) {
+    std::string data_directory = "data";
+    std::size_t jobs = std::max(1u, std::thread::hardware_concurrency());
+    std::vector<std::size_t> thread_counts;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view argument = argv[i];
+        if (argument.starts_with("--data=")) { data_directory = argument.substr(7); }
+        if (argument.starts_with("--jobs=")) { jobs = std::max(1ul, std::stoul(std::string(argument.substr(7)))); }
+        if (argument.starts_with("--sweep=")) {
+            std::stringstream counts{std::string(argument.substr(8))};
+            for (std::string count; std::getline(counts, count, ',');) { thread_counts.push_back(std::stoul(count)); }
+        }
+    }
+    const auto format = ElvenMeasure::report_format(argc, argv);
+    // Allocation counters are process-wide, and counted parts restart ElvenParallel's helpers, which must not pull
+    // them from under another running part.
+    if ((ElvenMeasure::Allocations::tracking || ElvenMeasure::PerfCounters::enabled()) && jobs > 1) {
+        std::cerr << "Allocation tracking and ELVEN_PERF measure one task at a time, running with --jobs=1" << std::endl;
+        jobs = 1;
+    }
+
+    std::vector<DayRun> runs;
+    for (const auto number: ElvenRunner::selected_days(argc, argv)) {
+        runs.emplace_back(&ElvenRunner::registered_day(number), input_path(data_directory, number));
+    }
+    if (!thread_counts.empty()) {
+        sweep(runs, thread_counts);
+        return 0;
+    }
+
+    const auto cores = static_cast<std::size_t>(std::max(1u, std::thread::hardware_concurrency()));
+    ElvenParallel::set_thread_count(cores - std::min(jobs, cores) + 1);
+    const auto cpu_start = ElvenMeasure::process_cpu_time();
+    const auto wall_start = std::chrono::steady_clock::now();
+    {
+        ElvenParallel::ThreadPool pool(jobs);
+        for (auto &run: runs) { schedule(pool, run); }
+        pool.wait();
+    }
+    const auto wall_time = std::chrono::duration_cast<ElvenMeasure::Time>(std::chrono::steady_clock::now() - wall_start);
+    const auto cpu_time = ElvenMeasure::process_cpu_time() - cpu_start;
+
+    ElvenMeasure::Time io_total{};
+    ElvenMeasure::Time parse_total{};
+    std::array<ElvenMeasure::Time, 2> part_totals{};
+    bool failed = false;
+    for (const auto &run: runs) {
+        for (std::size_t task = 0; task < run.failures.size(); ++task) {
+            if (!run.failures[task].has_value()) { continue; }
+            std::cerr << "Day " << run.day->number << " " << TASK_NAMES[task] << " failed: " << *run.failures[task]
+                      << std::endl;
+            failed = true;
+        }
+        if (run.failures[0].has_value()) { continue; }
+
+        ElvenMeasure::Reporter reporter(run.day->number, format);
+        reporter.add_io_report(run.io_time, run.input);
+        io_total += run.io_time;
+        if (run.parse_timing.has_value()) {
+            reporter.add_parse_report(*run.parse_timing);
+            parse_total += run.parse_timing->mean();
+        }
+        for (std::size_t i = 0; i < 2; ++i) {
+            if (!run.parts[i].has_value()) { continue; }
+            reporter.add_report(static_cast<int>(i + 1), run.parts[i]->first, run.parts[i]->second);
+            part_totals[i] += run.parts[i]->second.mean();
+        }
+
+        if (format != ElvenMeasure::ReportFormat::text) {
+            reporter.report();
+            continue;
+        }
+        std::cout << "Day " << run.day->number << std::endl;
+        reporter.report();
+        std::cout << "Tasks : I/O on worker " << run.workers[0];
+        if (run.parse_timing.has_value()) { std::cout << ", Parse on worker " << run.workers[1]; }
+        for (std::size_t i = 0; i < 2; ++i) {
+            if (!run.parts[i].has_value()) { continue; }
+            std::cout << ", Part" << i + 1 << " on worker " << run.workers[i + 2];
+        }
+        std::cout << std::endl << std::endl;
+    }
+
+    if (format == ElvenMeasure::ReportFormat::text) {
+        std::cout << "Total : " << ElvenMeasure::cast_time(io_total + parse_total + part_totals[0] + part_totals[1])
+                  << " (I/O " << ElvenMeasure::cast_time(io_total) << ", Parse " << ElvenMeasure::cast_time(parse_total)
+                  << ", Part1 " << ElvenMeasure::cast_time(part_totals[0])
+                  << ", Part2 " << ElvenMeasure::cast_time(part_totals[1]) << ", " << runs.size() << " days)" << std::endl;
+        const auto speedup = static_cast<double>(cpu_time.count()) / std::max<long long>(wall_time.count(), 1);
+        std::cout << "Wall  : " << ElvenMeasure::cast_time(wall_time) << " for " << ElvenMeasure::cast_time(cpu_time)
+                  << " of process CPU time on " << jobs << " workers and " << ElvenParallel::thread_count()
+                  << " data-parallel threads (x" << std::fixed << std::setprecision(2) << speedup << ")" << std::endl;
+    }
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,167 @@
+// Timing baselines over the Reporter's CSV output (--report=csv).
+//   baseline record <baseline.csv> <run.csv>...
+//   baseline compare <baseline.csv> <run.csv>... [--threshold=1.25] [--alpha=0.01]
+// compare exits with 1 when a phase's median got slower than `threshold` times the baseline and a one-sided
+// Mann-Whitney U test says it is slower at significance `alpha`, or when a solution changed.
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+#include "elven_measure.h"
+
+// Below this many samples on either side the U test has no power, the phase is only printed.
+constexpr std::size_t MIN_SAMPLES = 3;
+
+struct Phase {
+    std::vector<long long> samples;
+    std::string solution;
+};
+
+typedef std::pair<int, std::string> PhaseKey;
+typedef std::map<PhaseKey, Phase> Phases;
+
+// Reads `day,phase,iteration,ns,solution` rows, skipping the header each Reporter output starts with.
+void read_csv(const std::string &path, Phases &phases) {
+    std::ifstream file(path);
+    if (!file) { throw std::runtime_error("Unable to open " + path); }
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line.starts_with("day,")) { continue; }
+        std::stringstream row(line);
+        std::string day, phase, iteration, ns, solution;
+        std::getline(row, day, ',');
+        std::getline(row, phase, ',');
+        std::getline(row, iteration, ',');
+        std::getline(row, ns, ',');
+        std::getline(row, solution, ',');
+        if (day.empty() || phase.empty() || ns.empty()) { throw std::runtime_error("Malformed row in " + path + ": " + line); }
+
+        auto &entry = phases[{std::stoi(day), phase}];
+        entry.samples.push_back(std::stoll(ns));
+        entry.solution = solution;
+    }
+}
+
+void write_csv(const std::string &path, const Phases &phases) {
+    std::ofstream file(path);
+    if (!file) { throw std::runtime_error("Unable to write " + path); }
+    file << "day,phase,iteration,ns,solution\n";
+    for (const auto &[key, phase]: phases) {
+        for (std::size_t i = 0; i < phase.samples.size(); ++i) {
+            file << key.first << "," << key.second << "," << i << "," << phase.samples[i] << "," << phase.solution << "\n";
+        }
+    }
+}
+
+double median(std::vector<long long> samples) {
+    std::ranges::sort(samples);
+    const auto middle = samples.size() / 2;
+    return samples.size() % 2 == 1 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2.0;
+}
+
+// One-sided p-value of "current is not slower than baseline", normal approximation of U with tie and continuity
+// corrections.
+double mann_whitney_p_slower(const std::vector<long long> &baseline, const std::vector<long long> &current) {
+    std::vector<std::pair<long long, bool>> pooled;
+    for (const auto sample: baseline) { pooled.emplace_back(sample, false); }
+    for (const auto sample: current) { pooled.emplace_back(sample, true); }
+    std::ranges::sort(pooled);
+
+    const auto n = static_cast<double>(pooled.size());
+    const auto n1 = static_cast<double>(baseline.size());
+    const auto n2 = static_cast<double>(current.size());
+    double current_rank_sum = 0;
+    double tie_correction = 0;
+    for (std::size_t i = 0; i < pooled.size();) {
+        std::size_t j = i;
+        while (j < pooled.size() && pooled[j].first == pooled[i].first) { ++j; }
+        const double ties = j - i;
+        const double rank = (i + 1 + j) / 2.0;
+        for (std::size_t k = i; k < j; ++k) { if (pooled[k].second) { current_rank_sum += rank; } }
+        tie_correction += ties * ties * ties - ties;
+        i = j;
+    }
+
+    const double u = current_rank_sum - n2 * (n2 + 1) / 2;
+    const double variance = n1 * n2 / 12 * ((n + 1) - tie_correction / (n * (n - 1)));
+    if (variance <= 0) { return 1.0; }
+    const double z = (u - n1 * n2 / 2 - 0.5) / std::sqrt(variance);
+    return 0.5 * std::erfc(z / std::sqrt(2.0));
+}
+
+std::string describe(const PhaseKey &key) {
+    std::ostringstream out;
+    out << "day" << std::setw(2) << std::setfill('0') << key.first << " " << key.second;
+    return out.str();
+}
+
+std::string format_ns(const double ns) { return ElvenMeasure::cast_time(ElvenMeasure::Time(static_cast<long long>(ns))); }
+
+int compare(const Phases &baseline, const Phases &current, const double threshold, const double alpha) {
+    bool failed = false;
+    for (const auto &[key, phase]: current) {
+        const auto found = baseline.find(key);
+        if (found == baseline.end()) {
+            std::cout << describe(key) << ": no baseline" << std::endl;
+            continue;
+        }
+        const auto &reference = found->second;
+        if (!reference.solution.empty() && reference.solution != phase.solution) {
+            std::cout << describe(key) << ": SOLUTION CHANGED " << reference.solution << " -> " << phase.solution << std::endl;
+            failed = true;
+            continue;
+        }
+
+        const auto before = median(reference.samples);
+        const auto after = median(phase.samples);
+        const auto ratio = after / std::max(before, 1.0);
+        std::cout << describe(key) << ": " << format_ns(before) << " -> " << format_ns(after)
+                  << " (x" << std::fixed << std::setprecision(2) << ratio;
+        if (reference.samples.size() < MIN_SAMPLES || phase.samples.size() < MIN_SAMPLES) {
+            std::cout << ", too few samples)" << std::endl;
+            continue;
+        }
+        const auto p = mann_whitney_p_slower(reference.samples, phase.samples);
+        const bool regressed = ratio > threshold && p < alpha;
+        std::cout << ", p=" << std::setprecision(4) << p << ")" << (regressed ? " REGRESSION" : "") << std::endl;
+        failed |= regressed;
+    }
+    return failed ? 1 : 0;
+}
+
+int main(const int argc, char** argv) {
+    if (argc < 4) {
+        std::cerr << "usage: " << argv[0] << " record|compare <baseline.csv> <run.csv>... [--threshold=1.25] [--alpha=0.01]" << std::endl;
+        return 2;
+    }
+    const std::string command = argv[1];
+    const std::string baseline_path = argv[2];
+    double threshold = 1.25;
+    double alpha = 0.01;
+    Phases current;
+    for (int i = 3; i < argc; ++i) {
+        const std::string_view argument = argv[i];
+        if (argument.starts_with("--threshold=")) { threshold = std::stod(std::string(argument.substr(12))); }
+        else if (argument.starts_with("--alpha=")) { alpha = std::stod(std::string(argument.substr(8))); }
+        else { read_csv(argv[i], current); }
+    }
+
+    if (command == "record") {
+        Phases baseline;
+        if (std::ifstream(baseline_path)) { read_csv(baseline_path, baseline); }
+        for (auto &[key, phase]: current) { baseline[key] = std::move(phase); }
+        write_csv(baseline_path, baseline);
+        std::cout << "Recorded " << baseline.size() << " phases into " << baseline_path << std::endl;
+        return 0;
+    }
+    if (command == "compare") {
+        Phases baseline;
+        read_csv(baseline_path, baseline);
+        return compare(baseline, current, threshold, alpha);
+    }
+    std::cerr << "Unknown command " << command << std::endl;
+    return 2;
+}
@@ -0,0 +1,29 @@
+// Synthetic inputs for scaling runs, written to stdout.
+//   generate <day> <size> [seed=1]
+//   generate --list
+// The same day, size and seed always give the same input.
+
+#include <iostream>
+
+#include "elven_generate.h"
+
+int main(const int argc, char** argv) {
+    if (argc == 2 && std::string_view(argv[1]) == "--list") {
+        for (const auto &generator: ElvenGenerate::generators()) {
+            std::cout << "day" << std::setw(2) << std::setfill('0') << generator.day << std::setfill(' ')
+                      << " size = " << generator.unit << std::endl;
+        }
+        return 0;
+    }
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <day> <size> [seed=1] | --list" << std::endl;
+        return 2;
+    }
+    const int day = std::stoi(argv[1]);
+    const std::size_t size = std::stoul(argv[2]);
+    const std::uint64_t seed = argc > 3 ? std::stoull(argv[3]) : 1;
+
+    std::ios::sync_with_stdio(false);
+    ElvenGenerate::generate(std::cout, day, size, seed);
+    return 0;
+}
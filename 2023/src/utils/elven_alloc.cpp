@@ -0,0 +1,70 @@
+// Global operator new/delete replacements feeding ElvenMeasure::Allocations. Linked into every target when
+// ELVEN_TRACK_ALLOCATIONS is ON; replacements must be defined exactly once per program, so this is not a header.
+
+#include <cstdlib>
+#include <new>
+
+#include "elven_alloc.h"
+
+namespace {
+    constexpr std::size_t HEADER_SIZE = alignof(std::max_align_t);
+
+    // Every block carries its requested size and the offset back to the malloc'd address right before the pointer
+    // handed out, so unsized deletes can still be accounted for.
+    void *allocate(const std::size_t size, const std::size_t alignment) noexcept {
+        const std::size_t offset = alignment > HEADER_SIZE ? alignment : HEADER_SIZE;
+        void *block = alignment > HEADER_SIZE
+            ? std::aligned_alloc(alignment, (size + offset + alignment - 1) / alignment * alignment)
+            : std::malloc(size + offset);
+        if (block == nullptr) { return nullptr; }
+
+        auto *pointer = static_cast<char *>(block) + offset;
+        reinterpret_cast<std::size_t *>(pointer)[-1] = size;
+        reinterpret_cast<std::size_t *>(pointer)[-2] = offset;
+        ElvenMeasure::Allocations::record_allocation(size);
+        return pointer;
+    }
+
+    void *allocate_or_throw(const std::size_t size, const std::size_t alignment) {
+        void *pointer = allocate(size, alignment);
+        if (pointer == nullptr) { throw std::bad_alloc(); }
+        return pointer;
+    }
+
+    void deallocate(void *pointer) noexcept {
+        if (pointer == nullptr) { return; }
+        const auto *header = static_cast<const std::size_t *>(pointer);
+        ElvenMeasure::Allocations::record_deallocation(header[-1]);
+        std::free(static_cast<char *>(pointer) - header[-2]);
+    }
+}
+
+void *operator new(const std::size_t size) { return allocate_or_throw(size, HEADER_SIZE); }
+void *operator new[](const std::size_t size) { return allocate_or_throw(size, HEADER_SIZE); }
+void *operator new(const std::size_t size, const std::align_val_t alignment) {
+    return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void *operator new[](const std::size_t size, const std::align_val_t alignment) {
+    return allocate_or_throw(size, static_cast<std::size_t>(alignment));
+}
+void *operator new(const std::size_t size, const std::nothrow_t &) noexcept { return allocate(size, HEADER_SIZE); }
+void *operator new[](const std::size_t size, const std::nothrow_t &) noexcept { return allocate(size, HEADER_SIZE); }
+void *operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+void *operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t &) noexcept {
+    return allocate(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *pointer) noexcept { deallocate(pointer); }
+void operator delete[](void *pointer) noexcept { deallocate(pointer); }
+void operator delete(void *pointer, std::size_t) noexcept { deallocate(pointer); }
+void operator delete[](void *pointer, std::size_t) noexcept { deallocate(pointer); }
+void operator delete(void *pointer, std::align_val_t) noexcept { deallocate(pointer); }
+void operator delete[](void *pointer, std::align_val_t) noexcept { deallocate(pointer); }
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept { deallocate(pointer); }
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept { deallocate(pointer); }
+void operator delete(void *pointer, const std::nothrow_t &) noexcept { deallocate(pointer); }
+void operator delete[](void *pointer, const std::nothrow_t &) noexcept { deallocate(pointer); }
+void operator delete(void *pointer, std::align_val_t, const std::nothrow_t &) noexcept { deallocate(pointer); }
+void operator delete[](void *pointer, std::align_val_t, const std::nothrow_t &) noexcept { deallocate(pointer); }
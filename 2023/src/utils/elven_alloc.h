@@ -0,0 +1,58 @@
+#ifndef ELVEN_ALLOC_H
+#define ELVEN_ALLOC_H
+
+#include <atomic>
+#include <cstddef>
+
+namespace ElvenMeasure {
+
+    struct AllocationStats {
+        std::size_t count = 0;
+        std::size_t bytes = 0;
+        std::size_t peak_live_bytes = 0;
+    };
+
+    // Process-wide allocation counters, fed by the operator new/delete replacements in elven_alloc.cpp. That file is
+    // only linked in with -DELVEN_TRACK_ALLOCATIONS=ON, otherwise these stay at zero and `tracking` is false.
+    namespace Allocations {
+#ifdef ELVEN_TRACK_ALLOCATIONS
+        constexpr bool tracking = true;
+#else
+        constexpr bool tracking = false;
+#endif
+
+        inline std::atomic<std::size_t> count = 0;
+        inline std::atomic<std::size_t> bytes = 0;
+        inline std::atomic<std::size_t> live_bytes = 0;
+        inline std::atomic<std::size_t> peak_live_bytes = 0;
+
+        void inline record_allocation(const std::size_t size) {
+            count.fetch_add(1, std::memory_order_relaxed);
+            bytes.fetch_add(size, std::memory_order_relaxed);
+            const auto live = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+            auto peak = peak_live_bytes.load(std::memory_order_relaxed);
+            while (live > peak && !peak_live_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {}
+        }
+
+        void inline record_deallocation(const std::size_t size) {
+            live_bytes.fetch_sub(size, std::memory_order_relaxed);
+        }
+
+        // Starts a measured scope: the peak is measured from the bytes live right now.
+        [[nodiscard]] AllocationStats inline start() {
+            const auto live = live_bytes.load(std::memory_order_relaxed);
+            peak_live_bytes.store(live, std::memory_order_relaxed);
+            return {count.load(std::memory_order_relaxed), bytes.load(std::memory_order_relaxed), live};
+        }
+
+        // Allocations since `begin`, peak live bytes relative to the bytes live at `begin`.
+        [[nodiscard]] AllocationStats inline stop(const AllocationStats &begin) {
+            return {
+                count.load(std::memory_order_relaxed) - begin.count,
+                bytes.load(std::memory_order_relaxed) - begin.bytes,
+                peak_live_bytes.load(std::memory_order_relaxed) - begin.peak_live_bytes
+            };
+        }
+    }
+}
+#endif //ELVEN_ALLOC_H
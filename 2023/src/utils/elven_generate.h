@@ -0,0 +1,489 @@
+#ifndef ELVEN_GENERATE_H
+#define ELVEN_GENERATE_H
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <numeric>
+#include <ostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "elven_io.h"
+
+// Synthetic puzzle inputs of any size. Every generator writes an input the day's solvers accept and answer
+// deterministically for a given (size, seed); what `size` counts is per day, see Generator::unit.
+namespace ElvenGenerate {
+
+    typedef std::mt19937_64 Random;
+
+    std::size_t inline uniform(Random &random, const std::size_t low, const std::size_t high) {
+        return std::uniform_int_distribution<std::size_t>(low, high)(random);
+    }
+
+    bool inline chance(Random &random, const double probability) {
+        return std::bernoulli_distribution(probability)(random);
+    }
+
+    template<class T>
+    const T &pick(Random &random, const std::vector<T> &options) { return options[uniform(random, 0, options.size() - 1)]; }
+
+    char inline pick(Random &random, const std::string_view options) { return options[uniform(random, 0, options.size() - 1)]; }
+
+    // `side` x `side` cells drawn from `cell`.
+    template<class Cell>
+    void write_grid(std::ostream &out, const std::size_t side, Cell cell) {
+        std::string row(side, ' ');
+        for (std::size_t y = 0; y < side; ++y) {
+            for (std::size_t x = 0; x < side; ++x) { row[x] = cell(x, y); }
+            out << row << '\n';
+        }
+    }
+
+    // Lowercase name of `index` with at least `length` letters, distinct for distinct indices.
+    std::string inline letters(std::size_t index, const std::size_t length = 1) {
+        std::string name;
+        do {
+            name.insert(name.begin(), static_cast<char>('a' + index % 26));
+            index /= 26;
+        } while (index > 0 || name.size() < length);
+        return name;
+    }
+
+    // Lines of letters with at least one digit, spelled digits mixed in for part two.
+    void inline day01(std::ostream &out, const std::size_t lines, Random &random) {
+        static const std::vector<std::string> words{"one", "two", "three", "four", "five", "six", "seven", "eight", "nine"};
+        for (std::size_t i = 0; i < lines; ++i) {
+            std::string line;
+            const auto length = uniform(random, 4, 40);
+            while (line.size() < length) {
+                if (chance(random, 0.1)) {
+                    line += pick(random, words);
+                } else if (chance(random, 0.1)) {
+                    line += static_cast<char>('1' + uniform(random, 0, 8));
+                } else {
+                    line += static_cast<char>('a' + uniform(random, 0, 25));
+                }
+            }
+            line.insert(line.begin() + uniform(random, 0, line.size()), static_cast<char>('1' + uniform(random, 0, 8)));
+            out << line << '\n';
+        }
+    }
+
+    void inline day02(std::ostream &out, const std::size_t games, Random &random) {
+        std::array<std::string, 3> colors{"red", "green", "blue"};
+        for (std::size_t game = 1; game <= games; ++game) {
+            out << "Game " << game << ':';
+            const auto sets = uniform(random, 1, 6);
+            for (std::size_t set = 0; set < sets; ++set) {
+                std::ranges::shuffle(colors, random);
+                const auto count = uniform(random, 1, 3);
+                for (std::size_t color = 0; color < count; ++color) {
+                    out << ' ' << uniform(random, 1, 20) << ' ' << colors[color] << (color + 1 < count ? "," : "");
+                }
+                out << (set + 1 < sets ? ";" : "");
+            }
+            out << '\n';
+        }
+    }
+
+    void inline day03(std::ostream &out, const std::size_t side, Random &random) {
+        for (std::size_t y = 0; y < side; ++y) {
+            std::string row(side, '.');
+            for (std::size_t x = 0; x < side; ++x) {
+                if (chance(random, 0.04)) {
+                    row[x] = pick(random, "*#+$/@=%-&*");
+                } else if (chance(random, 0.12)) {
+                    const auto digits = std::min(uniform(random, 1, 3), side - x);
+                    row[x] = static_cast<char>('1' + uniform(random, 0, 8));
+                    for (std::size_t i = 1; i < digits; ++i) { row[x + i] = static_cast<char>('0' + uniform(random, 0, 9)); }
+                    x += digits;
+                }
+            }
+            out << row << '\n';
+        }
+    }
+
+    // Ten winning and twenty-five drawn numbers per card. A card never wins copies past the last card.
+    void inline day04(std::ostream &out, const std::size_t cards, Random &random) {
+        std::vector<int> numbers(99);
+        std::iota(numbers.begin(), numbers.end(), 1);
+        const auto width = std::to_string(cards).size();
+        for (std::size_t card = 1; card <= cards; ++card) {
+            std::ranges::shuffle(numbers, random);
+            const auto matches = std::min(uniform(random, 0, 10), cards - card);
+            std::vector drawn(numbers.begin() + 10 - matches, numbers.begin() + 35 - matches);
+            std::ranges::shuffle(drawn, random);
+            out << "Card " << std::setw(static_cast<int>(width)) << card << ':';
+            for (std::size_t i = 0; i < 10; ++i) { out << ' ' << std::setw(2) << numbers[i]; }
+            out << " |";
+            for (const auto number: drawn) { out << ' ' << std::setw(2) << number; }
+            out << '\n';
+        }
+    }
+
+    // `ranges` seed ranges and seven maps of `ranges` lines each. Every map permutes consecutive blocks of [0, 2^32).
+    void inline day05(std::ostream &out, const std::size_t ranges, Random &random) {
+        constexpr std::size_t UNIVERSE = std::size_t(1) << 32;
+        out << "seeds:";
+        for (std::size_t i = 0; i < ranges; ++i) {
+            const auto start = uniform(random, 0, UNIVERSE - 1);
+            out << ' ' << start << ' ' << uniform(random, 1, std::max<std::size_t>(1, std::min(UNIVERSE - start, UNIVERSE / ranges / 4)));
+        }
+        out << '\n';
+
+        const std::array<std::string, 8> names{"seed", "soil", "fertilizer", "water", "light", "temperature", "humidity", "location"};
+        for (std::size_t map = 0; map + 1 < names.size(); ++map) {
+            out << '\n' << names[map] << "-to-" << names[map + 1] << " map:\n";
+            std::vector<std::size_t> cuts{0, UNIVERSE};
+            while (cuts.size() < ranges + 1) { cuts.push_back(uniform(random, 1, UNIVERSE - 1)); }
+            std::ranges::sort(cuts);
+            cuts.erase(std::unique(cuts.begin(), cuts.end()), cuts.end());
+
+            std::vector<std::size_t> order(cuts.size() - 1);
+            std::iota(order.begin(), order.end(), 0);
+            std::ranges::shuffle(order, random);
+            std::size_t destination = 0;
+            for (const auto block: order) {
+                const auto length = cuts[block + 1] - cuts[block];
+                out << destination << ' ' << cuts[block] << ' ' << length << '\n';
+                destination += length;
+            }
+        }
+    }
+
+    // Every race can be won. Part two joins the races into one, which only fits 64 bits for up to four of them.
+    void inline day06(std::ostream &out, const std::size_t races, Random &random) {
+        std::vector<std::size_t> times;
+        std::vector<std::size_t> distances;
+        for (std::size_t i = 0; i < races; ++i) {
+            times.push_back(uniform(random, 7, 99));
+            distances.push_back(uniform(random, 0, times.back() * times.back() / 4 - 1));
+        }
+        out << "Time:    ";
+        for (const auto time: times) { out << std::setw(5) << time; }
+        out << "\nDistance:";
+        for (const auto distance: distances) { out << std::setw(5) << distance; }
+        out << '\n';
+    }
+
+    void inline day07(std::ostream &out, const std::size_t hands, Random &random) {
+        for (std::size_t i = 0; i < hands; ++i) {
+            std::string hand(5, ' ');
+            for (auto &card: hand) { card = pick(random, "23456789TJQKA"); }
+            out << hand << ' ' << uniform(random, 1, 1000) << '\n';
+        }
+    }
+
+    // Six ghost cycles, AAA to ZZZ among them. Both turns of a node lead to the same node, so the cycle lengths do
+    // not depend on the instructions, and they are distinct primes times a common factor to keep their LCM in 64 bits.
+    // Node names have three letters, which caps the size at 16224 nodes.
+    void inline day08(std::ostream &out, const std::size_t nodes, Random &random) {
+        std::array<std::size_t, 6> primes{43, 47, 53, 59, 61, 67};
+        std::ranges::shuffle(primes, random);
+        constexpr std::size_t MAX_NODES = 26 * 26 * 24;
+        const auto factor = std::max<std::size_t>(1, std::min(nodes, MAX_NODES) / (primes.size() * 67));
+
+        std::string instructions(uniform(random, 200, 300), 'L');
+        for (auto &instruction: instructions) { instruction = pick(random, "LR"); }
+        out << instructions << "\n\n";
+
+        // Inner node names never end in A or Z.
+        std::vector<std::size_t> free_names(MAX_NODES);
+        std::iota(free_names.begin(), free_names.end(), 0);
+        std::ranges::shuffle(free_names, random);
+        const auto inner_name = [&free_names] {
+            const auto index = free_names.back();
+            free_names.pop_back();
+            return std::string{static_cast<char>('A' + index / (26 * 24)), static_cast<char>('A' + index / 24 % 26), static_cast<char>('B' + index % 24)};
+        };
+
+        std::vector<std::string> lines;
+        for (std::size_t ghost = 0; ghost < primes.size(); ++ghost) {
+            const auto prefix = std::string(2, static_cast<char>('A' + ghost));
+            const auto start = prefix + 'A';
+            const auto end = ghost == 0 ? std::string("ZZZ") : prefix + 'Z';
+            std::vector<std::string> chain{start};
+            for (std::size_t i = 1; i < primes[ghost] * factor; ++i) { chain.push_back(inner_name()); }
+            chain.push_back(end);
+            for (std::size_t i = 0; i + 1 < chain.size(); ++i) {
+                lines.push_back(chain[i] + " = (" + chain[i + 1] + ", " + chain[i + 1] + ")");
+            }
+            lines.push_back(end + " = (" + chain[1] + ", " + chain[1] + ")");
+        }
+        std::ranges::shuffle(lines, random);
+        for (const auto &line: lines) { out << line << '\n'; }
+    }
+
+    // Values of polynomials up to degree six with small coefficients.
+    void inline day09(std::ostream &out, const std::size_t lines, Random &random) {
+        for (std::size_t i = 0; i < lines; ++i) {
+            std::vector<long long> coefficients(uniform(random, 1, 7));
+            for (auto &coefficient: coefficients) { coefficient = static_cast<long long>(uniform(random, 0, 10)) - 5; }
+            for (long long x = 0; x < 21; ++x) {
+                long long value = 0;
+                for (const auto coefficient: coefficients) { value = value * x + coefficient; }
+                out << (x > 0 ? " " : "") << value;
+            }
+            out << '\n';
+        }
+    }
+
+    // A rectangular loop from S at (1, 1) just inside the border, on a field of unconnected pipe junk.
+    void inline day10(std::ostream &out, const std::size_t side, Random &random) {
+        if (side < 4) { throw std::runtime_error("day10 needs a side of at least 4"); }
+        const auto last = side - 2;
+        write_grid(out, side, [&](const std::size_t x, const std::size_t y) {
+            if ((x == 1 && y == 0) || (x == 0 && y == 1)) { return '.'; }
+            if (x == 1 && y == 1) { return 'S'; }
+            const bool on_x = x >= 1 && x <= last;
+            const bool on_y = y >= 1 && y <= last;
+            if (x == last && y == 1) { return '7'; }
+            if (x == 1 && y == last) { return 'L'; }
+            if (x == last && y == last) { return 'J'; }
+            if ((y == 1 || y == last) && on_x) { return '-'; }
+            if ((x == 1 || x == last) && on_y) { return '|'; }
+            return pick(random, "|-LJ7F.......");
+        });
+    }
+
+    // Sparse galaxies, with some rows and columns left empty for the expansion.
+    void inline day11(std::ostream &out, const std::size_t side, Random &random) {
+        std::vector<bool> empty_columns(side);
+        for (std::size_t x = 0; x < side; ++x) { empty_columns[x] = chance(random, 0.05); }
+        for (std::size_t y = 0; y < side; ++y) {
+            const bool empty_row = chance(random, 0.05);
+            std::string row(side, '.');
+            for (std::size_t x = 0; x < side; ++x) {
+                if (!empty_row && !empty_columns[x] && chance(random, 0.02)) { row[x] = '#'; }
+            }
+            out << row << '\n';
+        }
+    }
+
+    // A random row of springs with its groups, then about half the springs hidden.
+    void inline day12(std::ostream &out, const std::size_t rows, Random &random) {
+        for (std::size_t i = 0; i < rows; ++i) {
+            std::string springs(uniform(random, 6, 20), '.');
+            for (auto &spring: springs) { spring = chance(random, 0.45) ? '#' : '.'; }
+            springs[uniform(random, 0, springs.size() - 1)] = '#';
+
+            std::vector<std::size_t> groups;
+            for (std::size_t x = 0; x < springs.size(); ++x) {
+                if (springs[x] != '#') { continue; }
+                if (x == 0 || springs[x - 1] != '#') { groups.push_back(0); }
+                ++groups.back();
+            }
+            for (auto &spring: springs) { if (chance(random, 0.5)) { spring = '?'; } }
+
+            out << springs << ' ';
+            for (std::size_t group = 0; group < groups.size(); ++group) { out << (group > 0 ? "," : "") << groups[group]; }
+            out << '\n';
+        }
+    }
+
+    // Sixteen `side` x `side` patterns, each mirrored around a column and a row. One cell right of the column's
+    // mirrored span is flipped: the column stays a clean reflection for part one, the row gets the smudge of part two.
+    void inline day13(std::ostream &out, const std::size_t side, Random &random) {
+        if (side < 9) { throw std::runtime_error("day13 needs a side of at least 9"); }
+        for (std::size_t pattern = 0; pattern < 16; ++pattern) {
+            std::vector<std::string> rows(side, std::string(side, '.'));
+            for (auto &row: rows) {
+                for (auto &cell: row) { cell = chance(random, 0.5) ? '#' : '.'; }
+            }
+
+            const auto column = uniform(random, 0, side / 2 - 2);
+            for (auto &row: rows) {
+                for (std::size_t x = 0; x <= column; ++x) { row[2 * column + 1 - x] = row[x]; }
+            }
+            const auto row = uniform(random, 0, side - 2);
+            const auto span = std::min(row + 1, side - row - 1);
+            for (std::size_t i = 0; i < span; ++i) { rows[row + 1 + i] = rows[row - i]; }
+
+            auto &smudge = rows[uniform(random, row + 1 - span, row + span)][uniform(random, 2 * column + 2, side - 1)];
+            smudge = smudge == '#' ? '.' : '#';
+
+            if (pattern > 0) { out << '\n'; }
+            for (const auto &line: rows) { out << line << '\n'; }
+        }
+    }
+
+    void inline day14(std::ostream &out, const std::size_t side, Random &random) {
+        write_grid(out, side, [&random](std::size_t, std::size_t) {
+            const auto roll = uniform(random, 0, 99);
+            return roll < 20 ? 'O' : roll < 35 ? '#' : '.';
+        });
+    }
+
+    // One line of steps over a pool of labels small enough for boxes to fill and empty again.
+    void inline day15(std::ostream &out, const std::size_t steps, Random &random) {
+        std::vector<std::string> labels(std::max<std::size_t>(1, steps / 4));
+        for (auto &label: labels) {
+            label.resize(uniform(random, 2, 6));
+            for (auto &c: label) { c = static_cast<char>('a' + uniform(random, 0, 25)); }
+        }
+        for (std::size_t i = 0; i < steps; ++i) {
+            out << (i > 0 ? "," : "") << pick(random, labels);
+            if (chance(random, 0.6)) {
+                out << '=' << uniform(random, 1, 9);
+            } else {
+                out << '-';
+            }
+        }
+        out << '\n';
+    }
+
+    void inline day16(std::ostream &out, const std::size_t side, Random &random) {
+        write_grid(out, side, [&random](std::size_t, std::size_t) { return chance(random, 0.06) ? pick(random, "|-\\/") : '.'; });
+    }
+
+    void inline day17(std::ostream &out, const std::size_t side, Random &random) {
+        write_grid(out, side, [&random](std::size_t, std::size_t) { return static_cast<char>('1' + uniform(random, 0, 8)); });
+    }
+
+    // Two independent staircases of `steps` right and down moves closed by one move left and one up: the plain
+    // instructions for part one, the colors for part two. The closing moves have to fit five hex digits.
+    void inline day18(std::ostream &out, const std::size_t steps, Random &random) {
+        constexpr std::size_t MAX_HEX = 0xFFFFF;
+        if (steps > MAX_HEX) { throw std::runtime_error("day18 supports at most 1048575 steps"); }
+        const auto staircase = [&random, steps](const std::size_t max_length) {
+            std::vector<std::pair<char, std::size_t>> moves;
+            std::size_t width = 0;
+            std::size_t height = 0;
+            for (std::size_t i = 0; i < steps; ++i) {
+                moves.emplace_back('R', uniform(random, 1, max_length));
+                moves.emplace_back('D', uniform(random, 1, max_length));
+                width += moves[moves.size() - 2].second;
+                height += moves.back().second;
+            }
+            moves.emplace_back('L', width);
+            moves.emplace_back('U', height);
+            return moves;
+        };
+        const auto plain = staircase(10);
+        const auto colored = staircase(std::max<std::size_t>(1, MAX_HEX / std::max<std::size_t>(steps, 1)));
+
+        const auto direction_digit = [](const char direction) { return direction == 'R' ? 0 : direction == 'D' ? 1 : direction == 'L' ? 2 : 3; };
+        for (std::size_t i = 0; i < plain.size(); ++i) {
+            out << plain[i].first << ' ' << plain[i].second << " (#" << std::hex << std::setw(5) << std::setfill('0')
+                << colored[i].second << direction_digit(colored[i].first) << std::dec << std::setfill(' ') << ")\n";
+        }
+    }
+
+    // A tree of `workflows` workflows rooted at "in": every condition and fallback either leads to a new workflow
+    // or accepts or rejects, so each workflow is reached once. As many parts follow.
+    void inline day19(std::ostream &out, const std::size_t workflows, Random &random) {
+        const auto name = [](const std::size_t index) { return index == 0 ? std::string("in") : letters(index, 3); };
+        std::vector<std::string> lines;
+        std::size_t next = 1;
+        for (std::size_t current = 0; current < std::min(next, workflows); ++current) {
+            const auto conditions = uniform(random, 1, 3);
+            const auto target = [&](const bool force_workflow) {
+                if (next < workflows && (force_workflow || chance(random, 0.5))) { return name(next++); }
+                return std::string(chance(random, 0.5) ? "A" : "R");
+            };
+            // The last open workflow always opens another one, so the tree only ends once all are placed.
+            std::string line = name(current) + '{';
+            for (std::size_t i = 0; i < conditions; ++i) {
+                line += pick(random, "xmas");
+                line += pick(random, "<>");
+                line += std::to_string(uniform(random, 1, 4000)) + ':' + target(i == 0 && current + 1 == next) + ',';
+            }
+            lines.push_back(line + target(false) + '}');
+        }
+        std::ranges::shuffle(lines, random);
+        for (const auto &line: lines) { out << line << '\n'; }
+
+        out << '\n';
+        for (std::size_t i = 0; i < workflows; ++i) {
+            out << "{x=" << uniform(random, 1, 4000) << ",m=" << uniform(random, 1, 4000)
+                << ",a=" << uniform(random, 1, 4000) << ",s=" << uniform(random, 1, 4000) << "}\n";
+        }
+    }
+
+    // `counters` twelve bit flip-flop counters, each read by a conjunction that resets it and feeds an inverter; the
+    // inverters meet in the conjunction in front of rx. Counter periods come from four primes so their LCM fits.
+    void inline day20(std::ostream &out, const std::size_t counters, Random &random) {
+        constexpr std::size_t BITS = 12;
+        std::vector<std::size_t> primes;
+        for (std::size_t candidate = 2049; candidate < 4096; candidate += 2) {
+            bool prime = true;
+            for (std::size_t divisor = 3; divisor * divisor <= candidate && prime; divisor += 2) { prime = candidate % divisor != 0; }
+            if (prime) { primes.push_back(candidate); }
+        }
+        std::ranges::shuffle(primes, random);
+        primes.resize(4);
+
+        const auto flipflop = [](const std::size_t counter, const std::size_t bit) { return "f" + letters(counter) + "b" + letters(bit); };
+        std::vector<std::string> lines;
+        std::string broadcaster = "broadcaster ->";
+        std::string collector = "&out -> rx";
+        for (std::size_t counter = 0; counter < counters; ++counter) {
+            const auto period = pick(random, primes);
+            const auto hub = "h" + letters(counter);
+            const auto inverter = "i" + letters(counter);
+            broadcaster += (counter > 0 ? ", " : " ") + flipflop(counter, 0);
+
+            std::string hub_line = "&" + hub + " -> " + inverter;
+            for (std::size_t bit = 0; bit < BITS; ++bit) {
+                const bool set = (period >> bit & 1) != 0;
+                std::vector<std::string> targets;
+                if (bit + 1 < BITS) { targets.push_back(flipflop(counter, bit + 1)); }
+                if (set) { targets.push_back(hub); }
+                if (!set || bit == 0) { hub_line += ", " + flipflop(counter, bit); }
+                std::string line = "%" + flipflop(counter, bit) + " ->";
+                for (std::size_t i = 0; i < targets.size(); ++i) { line += (i > 0 ? ", " : " ") + targets[i]; }
+                lines.push_back(line);
+            }
+            lines.push_back(hub_line);
+            lines.push_back("&" + inverter + " -> out");
+        }
+        lines.push_back(broadcaster);
+        lines.push_back(collector);
+        std::ranges::shuffle(lines, random);
+        for (const auto &line: lines) { out << line << '\n'; }
+    }
+
+    struct Generator {
+        int day;
+        const char *unit;
+        void (*write)(std::ostream &, std::size_t, Random &);
+    };
+
+    std::vector<Generator> inline &generators() {
+        static std::vector<Generator> all{
+            {1, "lines", day01}, {2, "games", day02}, {3, "side", day03}, {4, "cards", day04},
+            {5, "ranges", day05}, {6, "races", day06}, {7, "hands", day07}, {8, "nodes", day08},
+            {9, "lines", day09}, {10, "side", day10}, {11, "side", day11}, {12, "rows", day12},
+            {13, "side", day13}, {14, "side", day14}, {15, "steps", day15}, {16, "side", day16},
+            {17, "side", day17}, {18, "steps", day18}, {19, "workflows", day19}, {20, "counters", day20},
+        };
+        return all;
+    }
+
+    const Generator inline &generator(const int day) {
+        for (const auto &generator: generators()) {
+            if (generator.day == day) { return generator; }
+        }
+        throw std::runtime_error("No generator for day " + std::to_string(day));
+    }
+
+    void inline generate(std::ostream &out, const int day, const std::size_t size, const std::uint64_t seed) {
+        Random random(seed);
+        generator(day).write(out, size, random);
+    }
+
+    // The generated text indexed like a loaded file, for benchmarks that never touch the disk.
+    ElvenIO::input_type inline generate_input(const int day, const std::size_t size, const std::uint64_t seed) {
+        std::ostringstream text;
+        generate(text, day, size, seed);
+        const auto content = std::make_shared<const std::string>(std::move(text).str());
+        return {content, *content, "generated"};
+    }
+}
+#endif //ELVEN_GENERATE_H
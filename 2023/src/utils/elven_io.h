@@ -3,23 +3,277 @@
 
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <iterator>
 #include <vector>
+#include <cstring>
+#include <thread>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace ElvenIO {
 
-    typedef std::vector<std::string> input_type;
+    // A view over a single input line. It still converts implicitly to std::string so the solvers taking
+    // `const std::string &` keep working, paying the copy only there.
+    class Line : public std::string_view {
+    public:
+        using std::string_view::string_view;
+        Line() = default;
+        Line(const std::string_view view) : std::string_view(view) {}
+
+        operator std::string() const { return {data(), size()}; }
+    };
+
+    // Calls `f(line)` for every line starting in [chunk_begin, chunk_end). Same splitting as std::getline: no trailing
+    // empty line after the last '\n'.
+    template <class F>
+    void for_each_line(const std::string_view content, const std::size_t chunk_begin, const std::size_t chunk_end, const F &f) {
+        for (std::size_t position = chunk_begin; position < chunk_end;) {
+            const auto *newline = static_cast<const char *>(
+                std::memchr(content.data() + position, '\n', content.size() - position)
+            );
+            const std::size_t end = newline == nullptr ? content.size() : newline - content.data();
+            f(Line(content.data() + position, end - position));
+            position = end + 1;
+        }
+    }
+
+    // Start offsets of `count` pieces of `content` of about the same size, followed by its end. Each piece starts at
+    // the first line start at or past its nominal boundary, so every line lies in exactly one piece. Pieces may be
+    // empty when lines are longer than a piece.
+    std::vector<std::size_t> inline chunk_boundaries(const std::string_view content, const std::size_t count) {
+        std::vector<std::size_t> boundaries(count + 1, content.size());
+        boundaries[0] = 0;
+        for (std::size_t chunk = 1; chunk < count; ++chunk) {
+            const auto nominal = content.size() * chunk / count;
+            if (nominal == 0) {
+                boundaries[chunk] = 0;
+                continue;
+            }
+            const auto newline = content.find('\n', nominal - 1);
+            boundaries[chunk] = newline == std::string_view::npos ? content.size() : newline + 1;
+        }
+        return boundaries;
+    }
+
+    // `content` split at chunk_boundaries.
+    std::vector<std::string_view> inline line_chunks(const std::string_view content, const std::size_t count) {
+        const auto boundaries = chunk_boundaries(content, count);
+        std::vector<std::string_view> chunks;
+        chunks.reserve(count);
+        for (std::size_t chunk = 0; chunk < count; ++chunk) {
+            chunks.push_back(content.substr(boundaries[chunk], boundaries[chunk + 1] - boundaries[chunk]));
+        }
+        return chunks;
+    }
+
+    // Splits the buffer into cache-sized chunks at chunk_boundaries and indexes them on all cores. Lines are counted
+    // first, then written straight to their final slot, so the result is the same index as a serial pass.
+    std::vector<Line> inline index_lines(const std::string_view content) {
+        constexpr std::size_t CHUNK_SIZE = 256 * 1024;
+        const std::size_t chunk_count = (content.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        const std::size_t worker_count = std::min<std::size_t>(std::max(1u, std::thread::hardware_concurrency()), chunk_count);
+
+        std::vector<Line> lines;
+        if (worker_count <= 1) {
+            for_each_line(content, 0, content.size(), [&lines](const Line &line) { lines.push_back(line); });
+            return lines;
+        }
+
+        const auto chunk_starts = chunk_boundaries(content, chunk_count);
+
+        const auto run_on_all_workers = [worker_count, chunk_count](const auto &job) {
+            std::atomic<std::size_t> next_chunk = 0;
+            std::vector<std::thread> workers;
+            workers.reserve(worker_count);
+            for (std::size_t i = 0; i < worker_count; ++i) {
+                workers.emplace_back([&next_chunk, chunk_count, &job] {
+                    for (auto chunk = next_chunk++; chunk < chunk_count; chunk = next_chunk++) { job(chunk); }
+                });
+            }
+            for (auto &worker: workers) { worker.join(); }
+        };
+
+        std::vector<std::size_t> chunk_offsets(chunk_count + 1, 0);
+        run_on_all_workers([&](const std::size_t chunk) {
+            std::size_t count = 0;
+            for_each_line(content, chunk_starts[chunk], chunk_starts[chunk + 1], [&count](const Line &) { ++count; });
+            chunk_offsets[chunk + 1] = count;
+        });
+        std::partial_sum(chunk_offsets.begin(), chunk_offsets.end(), chunk_offsets.begin());
+
+        lines.resize(chunk_offsets.back());
+        run_on_all_workers([&](const std::size_t chunk) {
+            auto slot = lines.begin() + chunk_offsets[chunk];
+            for_each_line(content, chunk_starts[chunk], chunk_starts[chunk + 1], [&slot](const Line &line) { *slot++ = line; });
+        });
+        return lines;
+    }
+
+    // Index of lines over a single buffer. The buffer is either owned or memory mapped, `storage` keeps it alive
+    // while any copy of the index does.
+    class Lines {
+        std::shared_ptr<const void> storage;
+        std::string_view content;
+        std::vector<Line> lines;
+        std::string loader_name;
+
+    public:
+        typedef Line value_type;
+        typedef std::vector<Line>::const_iterator iterator;
+        typedef std::vector<Line>::const_iterator const_iterator;
+
+        Lines() = default;
+        Lines(std::shared_ptr<const void> storage, const std::string_view content, std::string loader_name)
+            : storage(std::move(storage)), content(content), lines(index_lines(content)), loader_name(std::move(loader_name)) {}
+
+        [[nodiscard]] const_iterator begin() const { return lines.begin(); }
+        [[nodiscard]] const_iterator end() const { return lines.end(); }
+        [[nodiscard]] std::size_t size() const { return lines.size(); }
+        [[nodiscard]] bool empty() const { return lines.empty(); }
+        const Line &operator[](const std::size_t i) const { return lines[i]; }
+        [[nodiscard]] const Line &front() const { return lines.front(); }
+        [[nodiscard]] const Line &back() const { return lines.back(); }
+
+        [[nodiscard]] std::string_view buffer() const { return content; }
+        [[nodiscard]] std::size_t size_bytes() const { return content.size(); }
+        [[nodiscard]] const std::string &loader() const { return loader_name; }
+    };
+
+    typedef Lines input_type;
 
     input_type inline read(const char *filename) {
         std::fstream file(filename);
 
-        std::string line;
-        input_type lines;
-        while (std::getline(file, line)) {
-            lines.emplace_back(line);
+        std::stringstream stream;
+        stream << file.rdbuf();
+        const auto content = std::make_shared<const std::string>(stream.str());
+
+        return {content, *content, "fstream"};
+    }
+
+    // Zero-copy loader: lines are views straight into the mapping.
+    input_type inline read_mapped(const char *filename) {
+        const int fd = open(filename, O_RDONLY);
+        if (fd < 0) { throw std::runtime_error(std::string("Unable to open ") + filename); }
+
+        struct stat file_stat{};
+        if (fstat(fd, &file_stat) < 0) {
+            close(fd);
+            throw std::runtime_error(std::string("Unable to stat ") + filename);
+        }
+        const auto size = static_cast<std::size_t>(file_stat.st_size);
+        if (size == 0) {
+            close(fd);
+            return {nullptr, {}, "mmap"};
+        }
+
+        void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) { throw std::runtime_error(std::string("Unable to map ") + filename); }
+        madvise(mapping, size, MADV_SEQUENTIAL);
+
+        const std::shared_ptr<const void> storage(mapping, [size](const void *address) {
+            munmap(const_cast<void *>(address), size);
+        });
+        return {storage, std::string_view(static_cast<const char *>(mapping), size), "mmap"};
+    }
+
+    // Forward-only line source over a bounded buffer, for inputs larger than memory. The buffer only grows past
+    // `chunk_size` to fit the longest line. A yielded line is valid until the stream advances.
+    class LineStream {
+        int fd = -1;
+        std::vector<char> buffer;
+        std::size_t begin_position = 0;
+        std::size_t end_position = 0;
+        bool exhausted = false;
+
+        bool fill() {
+            std::copy(buffer.begin() + begin_position, buffer.begin() + end_position, buffer.begin());
+            end_position -= begin_position;
+            begin_position = 0;
+            if (end_position == buffer.size()) { buffer.resize(buffer.size() * 2); }
+            const auto bytes_read = ::read(fd, buffer.data() + end_position, buffer.size() - end_position);
+            if (bytes_read <= 0) {
+                exhausted = true;
+                return false;
+            }
+            end_position += bytes_read;
+            return true;
         }
 
-        return std::move(lines);
+    public:
+        class iterator {
+            LineStream *stream = nullptr;
+            Line line;
+
+        public:
+            typedef std::input_iterator_tag iterator_category;
+            typedef Line value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const Line *pointer;
+            typedef const Line &reference;
+
+            iterator() = default;
+            explicit iterator(LineStream *stream) : stream(stream) { ++*this; }
+
+            reference operator*() const { return line; }
+            pointer operator->() const { return &line; }
+            iterator &operator++() {
+                if (!stream->next(line)) { stream = nullptr; }
+                return *this;
+            }
+            void operator++(int) { ++*this; }
+            bool operator==(const iterator &other) const { return stream == other.stream; }
+        };
+
+        explicit LineStream(const char *filename, const std::size_t chunk_size = 1 << 20) : buffer(chunk_size) {
+            fd = open(filename, O_RDONLY);
+            if (fd < 0) { throw std::runtime_error(std::string("Unable to open ") + filename); }
+            posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        }
+        LineStream(const LineStream &) = delete;
+        LineStream &operator=(const LineStream &) = delete;
+        ~LineStream() { close(fd); }
+
+        // Same splitting as std::getline: no trailing empty line after the last '\n'. The search resumes past the
+        // bytes already scanned, so a line longer than the buffer is read in linear time.
+        bool next(Line &line) {
+            std::size_t scanned = 0;
+            while (true) {
+                const auto *start = buffer.data() + begin_position;
+                const auto pending = end_position - begin_position;
+                if (const auto *newline = static_cast<const char *>(std::memchr(start + scanned, '\n', pending - scanned))) {
+                    line = Line(start, newline - start);
+                    begin_position += newline - start + 1;
+                    return true;
+                }
+                scanned = pending;
+                if (exhausted || !fill()) {
+                    if (begin_position == end_position) { return false; }
+                    line = Line(buffer.data() + begin_position, end_position - begin_position);
+                    begin_position = end_position;
+                    return true;
+                }
+            }
+        }
+
+        iterator begin() { return iterator(this); }
+        iterator end() { return {}; }
+    };
+
+    bool inline has_flag(const int argc, char **argv, const std::string_view flag) {
+        return std::any_of(argv + 1, argv + argc, [&flag](const char *argument) { return flag == argument; });
     }
 }
-#endif //ELVEN_IO_H
\ No newline at end of file
+#endif //ELVEN_IO_H
@@ -1,75 +1,509 @@
 #ifndef ELVEN_MEASURE
 #define ELVEN_MEASURE
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <optional>
 #include <string>
+#include <tuple>
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+
+#include "elven_alloc.h"
+#include "elven_parallel.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 namespace ElvenMeasure {
+    typedef std::chrono::duration<long long, std::ratio<1, 1000000000>> Time;
+
+    // Hardware and software counters of the measured iterations, averaged per iteration. A counter the kernel refused
+    // to open (no PMU in the container, perf_event_paranoid, ...) is left empty.
+    struct PerfSample {
+        std::optional<double> cycles;
+        std::optional<double> instructions;
+        std::optional<double> cache_misses;
+        std::optional<double> branch_misses;
+        std::optional<double> page_faults;
+
+        [[nodiscard]] std::optional<double> ipc() const {
+            if (!cycles.has_value() || !instructions.has_value() || *cycles == 0) { return std::nullopt; }
+            return *instructions / *cycles;
+        }
+    };
+
+    // perf_event_open counters for the calling thread and every thread it spawns while they are open, enabled with
+    // ELVEN_PERF=1. Each counter is opened on its own so the software ones still work where the hardware ones are
+    // unavailable.
+    class PerfCounters {
+        enum Counter { cycles, instructions, cache_misses, branch_misses, page_faults, counter_count };
+        std::array<int, counter_count> fds{};
+        std::string error;
+
+#ifdef __linux__
+        static int open_counter(const std::uint32_t type, const std::uint64_t config) {
+            perf_event_attr attributes{};
+            attributes.size = sizeof(attributes);
+            attributes.type = type;
+            attributes.config = config;
+            attributes.disabled = 1;
+            attributes.inherit = 1;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+        }
+#endif
+
+    public:
+        PerfCounters() {
+            fds.fill(-1);
+#ifdef __linux__
+            fds[cycles] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+            fds[instructions] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+            fds[cache_misses] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+            fds[branch_misses] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+            fds[page_faults] = open_counter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+            if (!available()) { error = std::strerror(errno); }
+#else
+            error = "perf_event_open is Linux only";
+#endif
+        }
+        PerfCounters(const PerfCounters &) = delete;
+        PerfCounters &operator=(const PerfCounters &) = delete;
+        ~PerfCounters() {
+#ifdef __linux__
+            for (const auto fd: fds) { if (fd >= 0) { close(fd); } }
+#endif
+        }
+
+        static bool enabled() {
+            static const bool enabled = [] {
+                const char *perf = std::getenv("ELVEN_PERF");
+                return perf != nullptr && std::string(perf) != "0";
+            }();
+            return enabled;
+        }
+
+        [[nodiscard]] bool available() const { return std::ranges::any_of(fds, [](const int fd) { return fd >= 0; }); }
+        [[nodiscard]] const std::string &unavailable_reason() const { return error; }
+
+        void start() {
+#ifdef __linux__
+            for (const auto fd: fds) {
+                if (fd >= 0) {
+                    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+                }
+            }
+#endif
+        }
+
+        [[nodiscard]] PerfSample stop(const std::size_t iterations) {
+            PerfSample sample;
+#ifdef __linux__
+            const auto read_counter = [this, iterations](const Counter counter) -> std::optional<double> {
+                std::uint64_t value = 0;
+                if (fds[counter] < 0) { return std::nullopt; }
+                ioctl(fds[counter], PERF_EVENT_IOC_DISABLE, 0);
+                if (::read(fds[counter], &value, sizeof(value)) != sizeof(value)) { return std::nullopt; }
+                return static_cast<double>(value) / std::max<std::size_t>(iterations, 1);
+            };
+            sample.cycles = read_counter(cycles);
+            sample.instructions = read_counter(instructions);
+            sample.cache_misses = read_counter(cache_misses);
+            sample.branch_misses = read_counter(branch_misses);
+            sample.page_faults = read_counter(page_faults);
+#endif
+            return sample;
+        }
+    };
+
+    // CPU time consumed by every thread of the process, zero where the clock is not available.
+    Time inline process_cpu_time() {
+#ifdef __linux__
+        timespec time{};
+        if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) == 0) {
+            return std::chrono::seconds(time.tv_sec) + std::chrono::nanoseconds(time.tv_nsec);
+        }
+#endif
+        return Time::zero();
+    }
+
+    // Per-iteration samples of one measured function. Converts to the mean so it can stand in for a plain Time.
+    struct Timing {
+        std::vector<Time> samples;
+        std::optional<PerfSample> counters;
+        std::string counters_error;
+        // Allocations per iteration and the highest live bytes above the starting point, with ELVEN_TRACK_ALLOCATIONS.
+        std::optional<AllocationStats> allocations;
+
+        // A timing of the one sample a caller measured on its own.
+        static Timing single(const Time sample) {
+            Timing timing;
+            timing.samples.push_back(sample);
+            return timing;
+        }
+
+        [[nodiscard]] std::size_t iterations() const { return samples.size(); }
+        [[nodiscard]] Time total() const { return std::accumulate(samples.begin(), samples.end(), Time::zero()); }
+        [[nodiscard]] Time mean() const { return samples.empty() ? Time::zero() : total() / static_cast<long long>(samples.size()); }
+        [[nodiscard]] Time min() const { return samples.empty() ? Time::zero() : *std::ranges::min_element(samples); }
+        // Nearest-rank percentile, p in [0, 100].
+        [[nodiscard]] Time percentile(const double p) const {
+            if (samples.empty()) { return Time::zero(); }
+            auto sorted = samples;
+            std::ranges::sort(sorted);
+            const auto rank = static_cast<std::size_t>(std::ceil(p / 100.0 * sorted.size()));
+            return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+        }
+        [[nodiscard]] Time median() const { return percentile(50); }
+        [[nodiscard]] Time stddev() const {
+            if (samples.size() < 2) { return Time::zero(); }
+            const auto average = static_cast<double>(mean().count());
+            const auto square_sum = std::transform_reduce(
+                samples.begin(), samples.end(),
+                0.0,
+                std::plus(),
+                [average](const Time sample) { return (sample.count() - average) * (sample.count() - average); }
+            );
+            return Time(static_cast<long long>(std::sqrt(square_sum / (samples.size() - 1))));
+        }
+
+        operator Time() const { return mean(); }
+    };
+
+    // Benchmark mode, enabled with ELVEN_BENCHMARK=1: runs ELVEN_WARMUP untimed iterations (default 3), then keeps
+    // sampling until ELVEN_TARGET_MS of measured time (default 1000) and at least the requested iterations.
+    struct BenchmarkSettings {
+        bool enabled = false;
+        std::size_t warmup = 3;
+        Time target = std::chrono::milliseconds(1000);
+        std::size_t max_iterations = 1'000'000;
+
+        static const BenchmarkSettings &get() {
+            static const BenchmarkSettings settings = [] {
+                BenchmarkSettings settings;
+                if (const char *enabled = std::getenv("ELVEN_BENCHMARK")) { settings.enabled = std::string(enabled) != "0"; }
+                if (const char *warmup = std::getenv("ELVEN_WARMUP")) { settings.warmup = std::stoul(warmup); }
+                if (const char *target = std::getenv("ELVEN_TARGET_MS")) { settings.target = std::chrono::milliseconds(std::stoul(target)); }
+                return settings;
+            }();
+            return settings;
+        }
+    };
+
     template <class F> 
     auto execute(const F& f, const std::size_t times=1) {
         using namespace std::chrono;
+        const auto &settings = BenchmarkSettings::get();
+
+        // Inherited counters only follow threads spawned after they open, so ElvenParallel's helpers are spawned
+        // again under them, by the warmup or the first iteration.
+        std::optional<PerfCounters> counters;
+        if (PerfCounters::enabled()) {
+            counters.emplace();
+            ElvenParallel::restart_shared_pool();
+        }
+        if (settings.enabled) {
+            for (std::size_t i = 0; i < settings.warmup; ++i) { f(); }
+        }
 
-        const auto start_time = high_resolution_clock::now();
-        
+        Timing timing;
+        timing.samples.reserve(times);
+        const auto allocations = Allocations::start();
+        if (counters.has_value()) { counters->start(); }
+        auto start_time = high_resolution_clock::now();
         auto result = f();
-        for(int i = 0; i < times-1; ++i) { f(); }
+        auto end_time = high_resolution_clock::now();
+        timing.samples.push_back(duration_cast<Time>(end_time - start_time));
 
-        const auto end_time = high_resolution_clock::now();
+        const auto keep_sampling = [&settings, &timing, times] {
+            if (!settings.enabled) { return timing.iterations() < times; }
+            return timing.iterations() < settings.max_iterations
+                && (timing.iterations() < times || timing.total() < settings.target);
+        };
+        while (keep_sampling()) {
+            start_time = high_resolution_clock::now();
+            f();
+            end_time = high_resolution_clock::now();
+            timing.samples.push_back(duration_cast<Time>(end_time - start_time));
+        }
+
+        if constexpr (Allocations::tracking) {
+            auto stats = Allocations::stop(allocations);
+            stats.count /= timing.iterations();
+            stats.bytes /= timing.iterations();
+            timing.allocations = stats;
+        }
+        if (counters.has_value()) {
+            if (counters->available()) {
+                timing.counters = counters->stop(timing.iterations());
+            } else {
+                timing.counters_error = counters->unavailable_reason();
+            }
+        }
 
-        return std::make_pair(result, (end_time - start_time) / times);
+        return std::make_pair(result, timing);
     }
 
-    unsigned long long inline operator"" _μs(const unsigned long long int val) { return val * 1'000; }
-    unsigned long long inline operator"" _ms(const unsigned long long int val) { return val * 1'000_μs; }
-    unsigned long long inline operator"" _s(const unsigned long long int val) { return val * 1'000_ms; }
-    unsigned long long inline operator"" _min(const unsigned long long int val) { return val * 60_s; }
-    unsigned long long inline operator"" _h(const unsigned long long int val) { return val * 60_min; }
-    unsigned long long inline operator"" _day(const unsigned long long int val) { return val * 24_h; }
+    // Nanoseconds, signed like Time::rep so they compare with counts without conversions.
+    long long inline operator"" _μs(const unsigned long long int val) { return static_cast<long long>(val) * 1'000; }
+    long long inline operator"" _ms(const unsigned long long int val) { return static_cast<long long>(val) * 1'000_μs; }
+    long long inline operator"" _s(const unsigned long long int val) { return static_cast<long long>(val) * 1'000_ms; }
+    long long inline operator"" _min(const unsigned long long int val) { return static_cast<long long>(val) * 60_s; }
+    long long inline operator"" _h(const unsigned long long int val) { return static_cast<long long>(val) * 60_min; }
+    long long inline operator"" _day(const unsigned long long int val) { return static_cast<long long>(val) * 24_h; }
 
+    // Human readable duration with two decimals in the largest unit that fits, "1.53ms" rather than a truncated "1ms".
     template <class TTime>
     std::string cast_time(const TTime &time) {
         using namespace std::chrono;
 
-        auto time_ns = time.count();
+        const auto time_ns = duration_cast<Time>(time).count();
+        const auto in_unit = [time_ns](const long long unit, const char *suffix) {
+            char buffer[64];
+            std::snprintf(buffer, sizeof(buffer), "%.2f%s", static_cast<double>(time_ns) / unit, suffix);
+            return std::string(buffer);
+        };
 
         if(time_ns < 1_μs) { return std::to_string(time_ns) + "ns"; }
-        if(time_ns < 1_ms) {
-            return std::to_string(time_ns / 1_μs) + "μs";
+        if(time_ns < 1_ms) { return in_unit(1_μs, "μs"); }
+        if(time_ns < 1_s) { return in_unit(1_ms, "ms"); }
+        if(time_ns < 1_min) { return in_unit(1_s, "s"); }
+        if(time_ns < 1_h) { return in_unit(1_min, "min"); }
+        if(time_ns < 1_day) { return in_unit(1_h, " hour(s)"); }
+        return in_unit(1_day, " day(s)");
+    }
+
+    enum class ReportFormat { text, json, csv };
+
+    // `--report=json|csv` on the command line wins over ELVEN_REPORT, text otherwise.
+    ReportFormat inline report_format(const int argc, char **argv) {
+        constexpr std::string_view flag = "--report=";
+        std::string format;
+        if (const char *environment = std::getenv("ELVEN_REPORT")) { format = environment; }
+        for (int i = 1; i < argc; ++i) {
+            if (const std::string_view argument = argv[i]; argument.starts_with(flag)) {
+                format = argument.substr(flag.size());
+            }
         }
-        if(time_ns < 1_s) {
-            return std::to_string(time_ns / 1_ms) + "ms";
+        if (format.empty() || format == "text") { return ReportFormat::text; }
+        if (format == "json") { return ReportFormat::json; }
+        if (format == "csv") { return ReportFormat::csv; }
+        throw std::runtime_error("Unknown report format " + format);
+    }
+
+    // Day number from a binary named like "day07", 0 when the name does not follow the pattern.
+    int inline day_from_program(const char *program) {
+        std::string_view name = program == nullptr ? "" : program;
+        if (const auto slash = name.find_last_of('/'); slash != std::string_view::npos) { name.remove_prefix(slash + 1); }
+        if (!name.starts_with("day")) { return 0; }
+        name.remove_prefix(3);
+        int day = 0;
+        std::from_chars(name.data(), name.data() + name.size(), day);
+        return day;
+    }
+
+    std::string inline json_escape(const std::string_view text) {
+        std::string escaped;
+        for (const char c: text) {
+            if (c == '"' || c == '\\') { escaped += '\\'; }
+            escaped += c;
         }
-        if(time_ns < 1_min) {
-            return std::to_string(time_ns / 1_s) + "s";
+        return escaped;
+    }
+
+    class Reporter {
+        int day = 0;
+        ReportFormat format = ReportFormat::text;
+        std::optional<Time> io_time;
+        std::string io_loader;
+        std::size_t io_bytes = 0;
+        std::size_t io_lines = 0;
+        // Timing of the day's parse phase when its parts share one parsed model, then each part's solve only.
+        std::optional<Timing> parse_timing;
+        std::vector<std::tuple<int, std::size_t, Timing>> reports;
+
+        // IPC plus misses and faults per input line, or per iteration when no input was reported.
+        void report_counters(const int part, const PerfSample &counters) const {
+            const auto per_line = [this](const std::optional<double> &value) -> std::optional<double> {
+                if (!value.has_value() || io_lines == 0) { return value; }
+                return *value / io_lines;
+            };
+            const auto unit = io_lines == 0 ? "/iteration" : "/line";
+            std::cout << "Part" << part << " perf:";
+            auto separator = " ";
+            const auto print = [&separator](const char *name, const std::optional<double> &value, const char *suffix) {
+                std::cout << separator << name << " ";
+                if (value.has_value()) { std::cout << *value << suffix; } else { std::cout << "n/a"; }
+                separator = ", ";
+            };
+            print("IPC", counters.ipc(), "");
+            print("cache-misses", per_line(counters.cache_misses), unit);
+            print("branch-misses", per_line(counters.branch_misses), unit);
+            print("page-faults", per_line(counters.page_faults), unit);
+            std::cout << std::endl;
         }
-        if(time_ns < 1_h) {
-            return std::to_string(time_ns / 1_min) + "min";
+
+        void report_text() const {
+            if (io_time.has_value()) {
+                std::cout << "I/O   : " << cast_time(*io_time);
+                if (!io_loader.empty()) {
+                    const auto io_ns = std::max<long long>(io_time->count(), 1);
+                    std::cout << " (" << io_loader << ", " << io_bytes << " bytes, " << io_lines << " lines, "
+                              << io_bytes * 1'000 / io_ns << " MB/s)";
+                }
+                std::cout << std::endl;
+            }
+            if (parse_timing.has_value()) {
+                std::cout << "Parse : " << cast_time(parse_timing->mean()) << std::endl;
+                if (parse_timing->allocations.has_value()) {
+                    std::cout << "Parse alloc: " << parse_timing->allocations->count << " allocations, "
+                              << parse_timing->allocations->bytes << " bytes" << std::endl;
+                }
+            }
+            for(const auto& [part, solution, timing]: reports) {
+                std::cout << "Part" << part << " : " << cast_time(timing.mean());
+                if (timing.iterations() > 1) {
+                    std::cout << " (min " << cast_time(timing.min()) << ", median " << cast_time(timing.median())
+                              << ", p95 " << cast_time(timing.percentile(95)) << ", stddev " << cast_time(timing.stddev())
+                              << ", n=" << timing.iterations() << ")";
+                }
+                std::cout << std::endl;
+            }
+            for(const auto& [part, solution, timing]: reports) {
+                if (timing.allocations.has_value()) {
+                    std::cout << "Part" << part << " alloc: " << timing.allocations->count << " allocations, "
+                              << timing.allocations->bytes << " bytes, peak live "
+                              << timing.allocations->peak_live_bytes << " bytes" << std::endl;
+                }
+                if (timing.counters.has_value()) {
+                    report_counters(part, *timing.counters);
+                } else if (!timing.counters_error.empty()) {
+                    std::cout << "Part" << part << " perf: unavailable (" << timing.counters_error << ")" << std::endl;
+                }
+            }
+            for(const auto& [part, solution, timing]: reports) {
+                std::cout << "Part" << part << " Solution: " << solution << std::endl;
+            }
         }
-        if(time_ns < 1_day) {
-            return std::to_string(time_ns / 1_h) + " hour(s)";
+
+        void report_json() const {
+            const auto optional_number = [](const auto &value) {
+                std::ostringstream out;
+                if (value.has_value()) { out << *value; } else { out << "null"; }
+                return out.str();
+            };
+            std::cout << "{\"day\":" << day << ",\"io\":";
+            if (io_time.has_value()) {
+                std::cout << "{\"ns\":" << io_time->count() << ",\"loader\":\"" << json_escape(io_loader)
+                          << "\",\"bytes\":" << io_bytes << ",\"lines\":" << io_lines << "}";
+            } else {
+                std::cout << "null";
+            }
+            std::cout << ",\"parse\":";
+            if (parse_timing.has_value()) {
+                std::cout << "{\"ns\":" << parse_timing->mean().count() << "}";
+            } else {
+                std::cout << "null";
+            }
+            std::cout << ",\"parts\":[";
+            for (std::size_t i = 0; i < reports.size(); ++i) {
+                const auto &[part, solution, timing] = reports[i];
+                std::cout << (i == 0 ? "" : ",") << "{\"part\":" << part << ",\"solution\":" << solution
+                          << ",\"iterations\":" << timing.iterations() << ",\"mean_ns\":" << timing.mean().count()
+                          << ",\"min_ns\":" << timing.min().count() << ",\"median_ns\":" << timing.median().count()
+                          << ",\"p95_ns\":" << timing.percentile(95).count() << ",\"stddev_ns\":" << timing.stddev().count()
+                          << ",\"samples_ns\":[";
+                for (std::size_t j = 0; j < timing.samples.size(); ++j) {
+                    std::cout << (j == 0 ? "" : ",") << timing.samples[j].count();
+                }
+                std::cout << "]";
+                if (timing.allocations.has_value()) {
+                    std::cout << ",\"allocations\":{\"count\":" << timing.allocations->count
+                              << ",\"bytes\":" << timing.allocations->bytes
+                              << ",\"peak_live_bytes\":" << timing.allocations->peak_live_bytes << "}";
+                }
+                if (timing.counters.has_value()) {
+                    const auto &counters = *timing.counters;
+                    std::cout << ",\"perf\":{\"cycles\":" << optional_number(counters.cycles)
+                              << ",\"instructions\":" << optional_number(counters.instructions)
+                              << ",\"cache_misses\":" << optional_number(counters.cache_misses)
+                              << ",\"branch_misses\":" << optional_number(counters.branch_misses)
+                              << ",\"page_faults\":" << optional_number(counters.page_faults) << "}";
+                }
+                std::cout << "}";
+            }
+            std::cout << "]}" << std::endl;
         }
-        return std::to_string(time_ns / 1_day) + " day(s)";
-    }
 
-    class Reporter {
-        typedef std::chrono::duration<long long, std::ratio<1, 1000000000>> Time;
-        Time io_time;
-        std::vector<std::tuple<int, std::size_t, Time>> reports;
+        // One row per sample, the I/O and parse phases as phases "io" and "parse" with an empty solution.
+        void report_csv() const {
+            std::cout << "day,phase,iteration,ns,solution" << std::endl;
+            if (io_time.has_value()) {
+                std::cout << day << ",io,0," << io_time->count() << "," << std::endl;
+            }
+            if (parse_timing.has_value()) {
+                for (std::size_t i = 0; i < parse_timing->samples.size(); ++i) {
+                    std::cout << day << ",parse," << i << "," << parse_timing->samples[i].count() << "," << std::endl;
+                }
+            }
+            for(const auto& [part, solution, timing]: reports) {
+                for (std::size_t i = 0; i < timing.samples.size(); ++i) {
+                    std::cout << day << ",part" << part << "," << i << "," << timing.samples[i].count() << ","
+                              << solution << std::endl;
+                }
+            }
+        }
 
     public:
+        Reporter() = default;
+        Reporter(const int argc, char **argv)
+            : day(day_from_program(argc > 0 ? argv[0] : nullptr)), format(report_format(argc, argv)) {}
+        Reporter(const int day, const ReportFormat format) : day(day), format(format) {}
+
         void add_io_report(const Time execution_time) {
             io_time = execution_time;
         }
+        template <class TInput>
+        void add_io_report(const Time execution_time, const TInput &input) {
+            io_time = execution_time;
+            io_loader = input.loader();
+            io_bytes = input.size_bytes();
+            io_lines = input.size();
+        }
+        void add_parse_report(const Timing &timing) {
+            parse_timing = timing;
+        }
         void add_report(const int part, const std::size_t solution, const Time execution_time) {
-            reports.emplace_back(part, solution, execution_time);
+            reports.emplace_back(part, solution, Timing::single(execution_time));
+        }
+        void add_report(const int part, const std::size_t solution, const Timing &timing) {
+            reports.emplace_back(part, solution, timing);
         }
 
-        void report() {
-            std::cout << "I/O   : " << cast_time(io_time) << std::endl;
-            for(const auto& [part, solution, execution_time]: reports) {
-                std::cout << "Part" << part << " : " << cast_time(execution_time) << std::endl;
-            }
-            for(const auto& [part, solution, execution_time]: reports) {
-                std::cout << "Part" << part << " Solution: " << solution << std::endl;
+        void report() const {
+            switch (format) {
+                case ReportFormat::text: report_text(); break;
+                case ReportFormat::json: report_json(); break;
+                case ReportFormat::csv: report_csv(); break;
             }
         }
     };
@@ -0,0 +1,239 @@
+#ifndef ELVEN_PARALLEL_H
+#define ELVEN_PARALLEL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace ElvenParallel {
+
+    // Work-stealing pool: every worker owns a deque, runs its own newest task first and steals the oldest task of the
+    // others when it runs dry. Tasks submitted from a worker stay on that worker's deque, outside submissions are
+    // spread round-robin.
+    class ThreadPool {
+        typedef std::function<void()> Task;
+
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        std::vector<std::unique_ptr<Queue>> queues;
+        std::vector<std::thread> workers;
+        std::mutex state_mutex;
+        std::condition_variable work_available;
+        std::condition_variable all_done;
+        std::atomic<std::size_t> queued = 0;
+        std::atomic<std::size_t> pending = 0;
+        std::atomic<std::size_t> next_queue = 0;
+        std::exception_ptr failure;
+        bool stopping = false;
+
+        static inline thread_local const ThreadPool *current_pool = nullptr;
+        static inline thread_local std::size_t current_worker = 0;
+
+        bool take(const std::size_t worker, Task &task) {
+            for (std::size_t i = 0; i < queues.size(); ++i) {
+                auto &queue = *queues[(worker + i) % queues.size()];
+                const std::lock_guard lock(queue.mutex);
+                if (queue.tasks.empty()) { continue; }
+                if (i == 0) {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                } else {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                }
+                --queued;
+                return true;
+            }
+            return false;
+        }
+
+        void run(const std::size_t worker) {
+            current_pool = this;
+            current_worker = worker;
+            while (true) {
+                if (Task task; take(worker, task)) {
+                    try {
+                        task();
+                    } catch (...) {
+                        const std::lock_guard lock(state_mutex);
+                        if (!failure) { failure = std::current_exception(); }
+                    }
+                    if (--pending == 0) {
+                        const std::lock_guard lock(state_mutex);
+                        all_done.notify_all();
+                    }
+                    continue;
+                }
+                std::unique_lock lock(state_mutex);
+                work_available.wait(lock, [this] { return stopping || queued > 0; });
+                if (stopping && queued == 0) { return; }
+            }
+        }
+
+    public:
+        explicit ThreadPool(const std::size_t worker_count = std::max(1u, std::thread::hardware_concurrency())) {
+            for (std::size_t i = 0; i < worker_count; ++i) { queues.push_back(std::make_unique<Queue>()); }
+            for (std::size_t i = 0; i < worker_count; ++i) { workers.emplace_back([this, i] { run(i); }); }
+        }
+        ThreadPool(const ThreadPool &) = delete;
+        ThreadPool &operator=(const ThreadPool &) = delete;
+        ~ThreadPool() {
+            {
+                const std::lock_guard lock(state_mutex);
+                stopping = true;
+            }
+            work_available.notify_all();
+            for (auto &worker: workers) { worker.join(); }
+        }
+
+        [[nodiscard]] std::size_t size() const { return workers.size(); }
+
+        // Index of the calling worker, only meaningful from inside a task.
+        [[nodiscard]] static std::size_t worker_index() { return current_worker; }
+
+        void submit(Task task) {
+            const auto worker = current_pool == this ? current_worker : next_queue++ % queues.size();
+            // Counted before it is visible, so a worker finishing it right away never drives the counters below zero.
+            {
+                const std::lock_guard lock(state_mutex);
+                ++pending;
+                ++queued;
+            }
+            {
+                const std::lock_guard lock(queues[worker]->mutex);
+                queues[worker]->tasks.push_back(std::move(task));
+            }
+            work_available.notify_one();
+        }
+
+        // Blocks until every submitted task, including the ones submitted by tasks, finished. Rethrows the first
+        // exception a task threw.
+        void wait() {
+            std::unique_lock lock(state_mutex);
+            all_done.wait(lock, [this] { return pending == 0; });
+            if (failure) { std::rethrow_exception(std::exchange(failure, nullptr)); }
+        }
+    };
+
+    // Threads used by the data-parallel helpers below, the caller included: ELVEN_THREADS or every core by default.
+    std::size_t inline &thread_count_setting() {
+        static std::size_t count = [] {
+            if (const char *threads = std::getenv("ELVEN_THREADS")) { return std::max<std::size_t>(1, std::stoul(threads)); }
+            return static_cast<std::size_t>(std::max(1u, std::thread::hardware_concurrency()));
+        }();
+        return count;
+    }
+
+    std::size_t inline thread_count() { return thread_count_setting(); }
+
+    // Helpers for parallel_for, one thread fewer than thread_count() since the caller works too. Resized on the next
+    // use after set_thread_count, which must not race with a running parallel_for.
+    struct SharedPool {
+        std::mutex mutex;
+        std::unique_ptr<ThreadPool> pool;
+    };
+
+    SharedPool inline &shared_pool_state() {
+        static SharedPool state;
+        return state;
+    }
+
+    ThreadPool inline &shared_pool() {
+        auto &[mutex, pool] = shared_pool_state();
+        const std::lock_guard lock(mutex);
+        if (pool == nullptr || pool->size() != thread_count() - 1) {
+            pool.reset();
+            pool = std::make_unique<ThreadPool>(thread_count() - 1);
+        }
+        return *pool;
+    }
+
+    // Joins the helpers, the next parallel_for spawns them again from its calling thread. Same restriction as
+    // set_thread_count.
+    void inline restart_shared_pool() {
+        auto &[mutex, pool] = shared_pool_state();
+        const std::lock_guard lock(mutex);
+        pool.reset();
+    }
+
+    void inline set_thread_count(const std::size_t count) { thread_count_setting() = std::max<std::size_t>(1, count); }
+
+    // Calls f(i) for every i in [0, count) on up to thread_count() threads. The caller claims indices too, so a
+    // parallel_for from inside a pool task cannot deadlock waiting for helpers that never get scheduled; a helper
+    // starting after all indices are claimed just returns.
+    template<class F>
+    void parallel_for(const std::size_t count, const F &f) {
+        if (thread_count() <= 1 || count <= 1) {
+            for (std::size_t i = 0; i < count; ++i) { f(i); }
+            return;
+        }
+
+        struct State {
+            std::atomic<std::size_t> next = 0;
+            std::atomic<std::size_t> done = 0;
+            std::mutex mutex;
+            std::condition_variable finished;
+            std::exception_ptr failure;
+        };
+        const auto state = std::make_shared<State>();
+        const auto work = [state, &f, count] {
+            for (auto i = state->next++; i < count; i = state->next++) {
+                try {
+                    f(i);
+                } catch (...) {
+                    const std::lock_guard lock(state->mutex);
+                    if (!state->failure) { state->failure = std::current_exception(); }
+                }
+                if (++state->done == count) {
+                    const std::lock_guard lock(state->mutex);
+                    state->finished.notify_all();
+                }
+            }
+        };
+
+        auto &pool = shared_pool();
+        for (std::size_t i = 0; i < std::min(pool.size(), count - 1); ++i) { pool.submit(work); }
+        work();
+        std::unique_lock lock(state->mutex);
+        state->finished.wait(lock, [&state, count] { return state->done == count; });
+        if (state->failure) { std::rethrow_exception(state->failure); }
+    }
+
+    // std::transform_reduce over random access ranges, split into ordered chunks of at least `grain` elements so the
+    // result matches the serial one for any associative `reduce`. Short ranges stay on the calling thread.
+    template<class Iterator, class T, class Reduce, class Transform>
+    T transform_reduce(
+        const Iterator first, const Iterator last, T init, const Reduce &reduce, const Transform &transform,
+        const std::size_t grain = 1024
+    ) {
+        const auto size = static_cast<std::size_t>(last - first);
+        const auto chunk_count = std::min(thread_count() * 4, size / std::max<std::size_t>(grain, 1));
+        if (thread_count() <= 1 || chunk_count <= 1) { return std::transform_reduce(first, last, init, reduce, transform); }
+
+        std::vector<std::optional<T>> partials(chunk_count);
+        parallel_for(chunk_count, [&](const std::size_t chunk) {
+            const auto begin = first + size * chunk / chunk_count;
+            const auto end = first + size * (chunk + 1) / chunk_count;
+            partials[chunk] = std::transform_reduce(begin + 1, end, static_cast<T>(transform(*begin)), reduce, transform);
+        });
+        for (auto &partial: partials) { init = reduce(std::move(init), std::move(*partial)); }
+        return init;
+    }
+}
+#endif //ELVEN_PARALLEL_H
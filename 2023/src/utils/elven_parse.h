@@ -0,0 +1,227 @@
+#ifndef ELVEN_PARSE_H
+#define ELVEN_PARSE_H
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ElvenParse {
+
+    [[nodiscard]] constexpr bool is_digit(const char c) { return c >= '0' && c <= '9'; }
+    [[nodiscard]] constexpr bool is_space(const char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n'; }
+
+    // Number of leading ASCII digits (0 to 8) in the 8 bytes at `text`. A byte below '0' borrows and one above '9'
+    // carries into its high bit; either only disturbs the bytes after it, so the lowest flagged byte is exact.
+    [[nodiscard]] inline std::size_t swar_digit_count(const char *text) {
+        std::uint64_t chunk;
+        std::memcpy(&chunk, text, sizeof(chunk));
+        const auto non_digits = ((chunk - 0x3030303030303030) | (chunk + 0x4646464646464646)) & 0x8080808080808080;
+        return non_digits == 0 ? 8 : std::countr_zero(non_digits) / 8;
+    }
+
+    // Value of the `length` (1 to 8) ASCII digits at `text`, which must have 8 readable bytes. The digits are moved
+    // to the top of a little-endian word, so the bytes past them fall off and the freed low bytes read as leading
+    // zeros, then pairs, quads and octets of digits are combined with three multiplications.
+    [[nodiscard]] inline std::uint32_t swar_digits(const char *text, const std::size_t length) {
+        std::uint64_t chunk;
+        std::memcpy(&chunk, text, sizeof(chunk));
+        chunk <<= (8 - length) * 8;
+        chunk = (chunk & 0x0F0F0F0F0F0F0F0F) * 2561 >> 8;
+        chunk = (chunk & 0x00FF00FF00FF00FF) * 6553601 >> 16;
+        return static_cast<std::uint32_t>((chunk & 0x0000FFFF0000FFFF) * 42949672960001 >> 32);
+    }
+
+    // Parses an integer at the start of [first, last), returning the end of the number or nullptr when there is none.
+    // Numbers of up to 8 digits with 8 readable bytes take the SWAR path, everything else goes to std::from_chars.
+    template<std::integral T>
+    const char *parse_int(const char *first, const char *last, T &value) {
+        const char *digits = first;
+        if constexpr (std::is_signed_v<T>) {
+            if (digits != last && *digits == '-') { ++digits; }
+        }
+
+        if constexpr (std::endian::native == std::endian::little && std::numeric_limits<T>::digits10 >= 8) {
+            if (last - digits >= 8) {
+                const auto length = swar_digit_count(digits);
+                if (length == 0) { return nullptr; }
+                if (length < 8 || digits + 8 == last || !is_digit(digits[8])) {
+                    const auto magnitude = static_cast<T>(swar_digits(digits, length));
+                    value = digits != first ? static_cast<T>(-magnitude) : magnitude;
+                    return digits + length;
+                }
+            }
+        }
+        if (digits == last || !is_digit(*digits)) { return nullptr; }
+        const auto [end, error] = std::from_chars(first, last, value);
+        return error == std::errc() ? end : nullptr;
+    }
+
+    // Whole-token conversion, throws when the token is not exactly one integer in `base`.
+    template<std::integral T>
+    T to_int(const std::string_view token, const int base = 10) {
+        T value{};
+        const auto *last = token.data() + token.size();
+        const auto *end = base == 10
+            ? parse_int(token.data(), last, value)
+            : std::from_chars(token.data(), last, value, base).ptr;
+        if (end != last || token.empty()) { throw std::runtime_error("Not an integer: " + std::string(token)); }
+        return value;
+    }
+
+    // Forward-only reader over a line or buffer. Nothing is copied: tokens are views into the parsed text.
+    class Cursor {
+        const char *position;
+        const char *last;
+
+    public:
+        explicit Cursor(const std::string_view text) : position(text.data()), last(text.data() + text.size()) {}
+
+        [[nodiscard]] bool done() const { return position == last; }
+        [[nodiscard]] std::string_view rest() const { return {position, static_cast<std::size_t>(last - position)}; }
+        [[nodiscard]] char peek() const { return done() ? '\0' : *position; }
+
+        Cursor &skip(const std::size_t count) {
+            position += std::min<std::size_t>(count, last - position);
+            return *this;
+        }
+
+        Cursor &skip_whitespace() {
+            while (position != last && is_space(*position)) { ++position; }
+            return *this;
+        }
+
+        // Consumes `prefix` when the text continues with it.
+        bool skip_prefix(const std::string_view prefix) {
+            if (!rest().starts_with(prefix)) { return false; }
+            position += prefix.size();
+            return true;
+        }
+
+        // Moves past the next `delimiter`, or to the end when there is none.
+        Cursor &skip_past(const char delimiter) {
+            read_until(delimiter);
+            return *this;
+        }
+
+        // The text up to the next `delimiter` (or the end), consuming the delimiter.
+        std::string_view read_until(const char delimiter) {
+            const auto *found = static_cast<const char *>(std::memchr(position, delimiter, last - position));
+            const auto *end = found == nullptr ? last : found;
+            const std::string_view token(position, end - position);
+            position = found == nullptr ? last : found + 1;
+            return token;
+        }
+
+        // The next run of non-whitespace characters after any whitespace.
+        std::string_view read_word() {
+            skip_whitespace();
+            const auto *start = position;
+            while (position != last && !is_space(*position)) { ++position; }
+            return {start, static_cast<std::size_t>(position - start)};
+        }
+
+        // The next integer after any whitespace, nothing (and nothing consumed but the whitespace) when the text
+        // does not continue with one.
+        template<std::integral T>
+        std::optional<T> try_read_int() {
+            skip_whitespace();
+            T value{};
+            const auto *end = parse_int(position, last, value);
+            if (end == nullptr) { return std::nullopt; }
+            position = end;
+            return value;
+        }
+
+        template<std::integral T>
+        T read_int() {
+            if (const auto value = try_read_int<T>()) { return *value; }
+            throw std::runtime_error("Expected an integer at: " + std::string(rest().substr(0, 16)));
+        }
+
+        // Every whitespace-separated integer up to the end or the first token that is not one.
+        template<std::integral T>
+        std::vector<T> read_ints() {
+            std::vector<T> values;
+            while (const auto value = try_read_int<T>()) { values.push_back(*value); }
+            return values;
+        }
+    };
+
+    // Range over the `delimiter`-separated fields of a text, "a,b,,c" yields "a", "b", "" and "c". An empty text
+    // has no fields.
+    class Split {
+        std::string_view text;
+        char delimiter;
+
+    public:
+        class iterator {
+            std::string_view remaining;
+            std::string_view field;
+            char delimiter = ',';
+            bool at_end = true;
+
+            void advance() {
+                if (remaining.data() == nullptr) {
+                    at_end = true;
+                    return;
+                }
+                const auto found = remaining.find(delimiter);
+                field = remaining.substr(0, found);
+                remaining = found == std::string_view::npos ? std::string_view() : remaining.substr(found + 1);
+            }
+
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef std::string_view value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef const std::string_view *pointer;
+            typedef const std::string_view &reference;
+
+            iterator() = default;
+            iterator(const std::string_view text, const char delimiter)
+                : remaining(text.empty() ? std::string_view() : text), delimiter(delimiter), at_end(text.empty()) {
+                if (!at_end) { advance(); }
+            }
+
+            reference operator*() const { return field; }
+            pointer operator->() const { return &field; }
+            iterator &operator++() {
+                advance();
+                return *this;
+            }
+            iterator operator++(int) {
+                auto previous = *this;
+                advance();
+                return previous;
+            }
+            bool operator==(const iterator &other) const {
+                if (at_end || other.at_end) { return at_end == other.at_end; }
+                return field.data() == other.field.data();
+            }
+        };
+
+        Split(const std::string_view text, const char delimiter) : text(text), delimiter(delimiter) {}
+
+        [[nodiscard]] iterator begin() const { return {text, delimiter}; }
+        [[nodiscard]] iterator end() const { return {}; }
+    };
+
+    // Every integer of a `delimiter`-separated list such as "1,1,3".
+    template<std::integral T>
+    std::vector<T> split_ints(const std::string_view text, const char delimiter = ',') {
+        std::vector<T> values;
+        for (const auto field: Split(text, delimiter)) { values.push_back(to_int<T>(field)); }
+        return values;
+    }
+}
+#endif //ELVEN_PARSE_H
@@ -0,0 +1,182 @@
+#ifndef ELVEN_RUNNER_H
+#define ELVEN_RUNNER_H
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "elven_io.h"
+#include "elven_measure.h"
+
+namespace ElvenRunner {
+
+    typedef std::size_t (*Solver)(const ElvenIO::input_type &);
+    typedef std::size_t (*StreamSolver)(ElvenIO::LineStream &&);
+    // The typed model a day parses its input into once, shared read-only by both parts. It may hold views into the
+    // input, which has to outlive it.
+    typedef std::shared_ptr<const void> Model;
+    typedef Model (*Parser)(const ElvenIO::input_type &);
+    typedef std::size_t (*ModelSolver)(const void *);
+
+    // One puzzle day as registered by ELVEN_DAY or ELVEN_PARSED_DAY. A missing part, stream solver or parser is left
+    // null. Days with a parser still have full-input solvers that parse on every call, for the callers that time a
+    // part on its own.
+    struct Day {
+        int number = 0;
+        std::size_t times = 1;
+        Solver part1 = nullptr;
+        Solver part2 = nullptr;
+        StreamSolver stream_part1 = nullptr;
+        StreamSolver stream_part2 = nullptr;
+        Parser parse = nullptr;
+        ModelSolver model_part1 = nullptr;
+        ModelSolver model_part2 = nullptr;
+
+        [[nodiscard]] std::array<Solver, 2> parts() const { return {part1, part2}; }
+        [[nodiscard]] std::array<ModelSolver, 2> model_parts() const { return {model_part1, model_part2}; }
+    };
+
+    Day inline with_model(Day day, const Parser parse, const ModelSolver part1, const ModelSolver part2) {
+        day.parse = parse;
+        day.model_part1 = part1;
+        day.model_part2 = part2;
+        return day;
+    }
+
+    // Every day linked into the runner, sorted by number on first use since static initialization order across
+    // translation units is unspecified.
+    std::vector<Day> inline &registry() {
+        static std::vector<Day> days;
+        return days;
+    }
+
+    std::vector<Day> inline &sorted_registry() {
+        auto &days = registry();
+        std::ranges::sort(days, {}, &Day::number);
+        return days;
+    }
+
+    struct Registration {
+        explicit Registration(const Day &day) { registry().push_back(day); }
+    };
+
+    const Day inline &registered_day(const int number) {
+        const auto &days = sorted_registry();
+        const auto day = std::ranges::find(days, number, &Day::number);
+        if (day == days.end()) { throw std::runtime_error("Day " + std::to_string(number) + " is not registered"); }
+        return *day;
+    }
+
+    // Day numbers and inclusive ranges ("3", "1-5") among the arguments, all registered days when none is given.
+    std::set<int> inline selected_days(const int argc, char **argv) {
+        std::set<int> days;
+        for (int i = 1; i < argc; ++i) {
+            const std::string argument = argv[i];
+            if (argument.starts_with("--")) { continue; }
+            const auto dash = argument.find('-');
+            const int first = std::stoi(argument.substr(0, dash));
+            const int last = dash == std::string::npos ? first : std::stoi(argument.substr(dash + 1));
+            for (int day = first; day <= last; ++day) { days.insert(day); }
+        }
+        if (days.empty()) {
+            for (const auto &day: sorted_registry()) { days.insert(day.number); }
+        }
+        return days;
+    }
+
+    // Parses the loaded input into the day's model, timed once, nothing when the day has no parser.
+    std::optional<std::pair<Model, ElvenMeasure::Timing>> inline run_parse(const Day &day, const ElvenIO::input_type &input) {
+        if (day.parse == nullptr) { return std::nullopt; }
+        const auto parse = day.parse;
+        return ElvenMeasure::execute([parse, &input] { return parse(input); });
+    }
+
+    // Times part `index` (0 or 1) on the parsed model when one is given, otherwise on the loaded input, nothing when
+    // the day does not have that part.
+    std::optional<std::pair<std::size_t, ElvenMeasure::Timing>> inline run_part(
+        const Day &day, const std::size_t index, const ElvenIO::input_type &input, const Model &model = nullptr
+    ) {
+        if (model != nullptr) {
+            const auto solver = day.model_parts()[index];
+            if (solver == nullptr) { return std::nullopt; }
+            return ElvenMeasure::execute([solver, data = model.get()] { return solver(data); }, day.times);
+        }
+        const auto solver = day.parts()[index];
+        if (solver == nullptr) { return std::nullopt; }
+        return ElvenMeasure::execute([solver, &input] { return solver(input); }, day.times);
+    }
+
+    void inline run_parts(const Day &day, const ElvenIO::input_type &input, ElvenMeasure::Reporter &reporter) {
+        Model model;
+        if (auto parsed = run_parse(day, input)) {
+            model = std::move(parsed->first);
+            reporter.add_parse_report(parsed->second);
+        }
+        for (std::size_t i = 0; i < 2; ++i) {
+            if (const auto part = run_part(day, i, input, model)) {
+                reporter.add_report(static_cast<int>(i + 1), part->first, part->second);
+            }
+        }
+    }
+
+    // The standalone `dayNN <input> [--stream] [--report=...]` entry point.
+    int inline run_day(const Day &day, const int argc, char **argv) {
+        ElvenMeasure::Reporter reporter(argc, argv);
+        if (day.stream_part1 != nullptr && ElvenIO::has_flag(argc, argv, "--stream")) {
+            for (const auto &[part, solver]: {std::pair(1, day.stream_part1), std::pair(2, day.stream_part2)}) {
+                const auto [result, timing] = ElvenMeasure::execute([solver, argv] { return solver(ElvenIO::LineStream(argv[1])); });
+                reporter.add_report(part, result, timing);
+            }
+            reporter.report();
+            return 0;
+        }
+        const auto [input, io_time] = ElvenMeasure::execute([=]{ return ElvenIO::read_mapped(argv[1]); });
+        reporter.add_io_report(io_time, input);
+        run_parts(day, input, reporter);
+        reporter.report();
+        return 0;
+    }
+}
+
+#define ELVEN_SOLVER(function) [](const ElvenIO::input_type &input) -> std::size_t { return function(input); }
+#define ELVEN_STREAM_SOLVER(function) [](ElvenIO::LineStream &&lines) -> std::size_t { return function(std::move(lines)); }
+
+// The model type `parse` returns, and the parser, model solver and full-input solver built around it.
+#define ELVEN_MODEL_TYPE(parse) std::remove_cvref_t<decltype(parse(std::declval<const ElvenIO::input_type &>()))>
+#define ELVEN_PARSER(parse) \
+    [](const ElvenIO::input_type &input) -> ElvenRunner::Model { \
+        return std::make_shared<ELVEN_MODEL_TYPE(parse)>(parse(input)); \
+    }
+#define ELVEN_MODEL_SOLVER(parse, function) \
+    [](const void *model) -> std::size_t { return function(*static_cast<const ELVEN_MODEL_TYPE(parse) *>(model)); }
+#define ELVEN_PARSED_SOLVER(parse, function) \
+    [](const ElvenIO::input_type &input) -> std::size_t { return function(parse(input)); }
+
+// ELVEN_REGISTER_DAY(day) registers the day with elven_runner when built with ELVEN_RUNNER, otherwise expands to the
+// day's own main.
+#ifdef ELVEN_RUNNER
+#define ELVEN_REGISTER_DAY(...) static const ElvenRunner::Registration elven_day_registration(__VA_ARGS__);
+#else
+#define ELVEN_REGISTER_DAY(...) int main(int argc, char** argv) { return ElvenRunner::run_day(__VA_ARGS__, argc, argv); }
+#endif
+
+// ELVEN_DAY(number, times, part1 [, part2 [, stream_part1, stream_part2]])
+#define ELVEN_DAY(...) ELVEN_REGISTER_DAY(ElvenRunner::Day{__VA_ARGS__})
+
+// ELVEN_PARSED_DAY(number, times, parse, part1, part2 [, stream_part1, stream_part2]) for days whose parts both take
+// the model `parse` returns: it is parsed once and timed as its own phase.
+#define ELVEN_PARSED_DAY(number, times, parse, part1, part2, ...) \
+    ELVEN_REGISTER_DAY(ElvenRunner::with_model( \
+        ElvenRunner::Day{ \
+            number, times, ELVEN_PARSED_SOLVER(parse, part1), ELVEN_PARSED_SOLVER(parse, part2) __VA_OPT__(,) __VA_ARGS__ \
+        }, \
+        ELVEN_PARSER(parse), ELVEN_MODEL_SOLVER(parse, part1), ELVEN_MODEL_SOLVER(parse, part2) \
+    ))
+
+#endif //ELVEN_RUNNER_H
@@ -1,8 +1,25 @@
 #ifndef ELVEN_UTILS_H
 #define ELVEN_UTILS_H
 
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <numeric>
+#include <optional>
 #include <set>
 #include <deque>
+#include <ranges>
+#include <span>
+#include <vector>
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <tuple>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
 
 namespace ElvenUtils {
     typedef long X;
@@ -54,140 +71,378 @@ namespace ElvenUtils {
     };
 
 
+    constexpr std::size_t SCAN_BLOCK = 64;
+
+    // Bit i is set when block[i] == element, for the SCAN_BLOCK bytes starting at block. AVX2 compares 32 bytes per
+    // instruction, SSE2 16, the scalar fallback one.
+    inline std::uint64_t match_mask(const char *block, const char element) {
+#if defined(__AVX2__)
+        const auto needle = _mm256_set1_epi8(element);
+        const auto low = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(block)), needle)
+        ));
+        const auto high = static_cast<std::uint32_t>(_mm256_movemask_epi8(
+            _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(block + 32)), needle)
+        ));
+        return static_cast<std::uint64_t>(high) << 32 | low;
+#elif defined(__SSE2__)
+        const auto needle = _mm_set1_epi8(element);
+        std::uint64_t mask = 0;
+        for (std::size_t i = 0; i < SCAN_BLOCK; i += 16) {
+            const auto lane = static_cast<std::uint16_t>(_mm_movemask_epi8(
+                _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i)), needle)
+            ));
+            mask |= static_cast<std::uint64_t>(lane) << i;
+        }
+        return mask;
+#else
+        std::uint64_t mask = 0;
+        for (std::size_t i = 0; i < SCAN_BLOCK; ++i) {
+            mask |= static_cast<std::uint64_t>(block[i] == element) << i;
+        }
+        return mask;
+#endif
+    }
+
+    // Bit i is set when low <= block[i] <= high, for the SCAN_BLOCK bytes starting at block, such as '0' to '9' for
+    // the digits. Both bounds must be ASCII above '\0' and below DEL: the vector paths compare signed bytes, so bytes
+    // from 0x80 up never match.
+    inline std::uint64_t range_mask(const char *block, const char low, const char high) {
+#if defined(__AVX2__)
+        const auto below = _mm256_set1_epi8(static_cast<char>(low - 1));
+        const auto above = _mm256_set1_epi8(static_cast<char>(high + 1));
+        const auto lane = [&below, &above](const char *bytes) {
+            const auto chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bytes));
+            return static_cast<std::uint32_t>(_mm256_movemask_epi8(
+                _mm256_and_si256(_mm256_cmpgt_epi8(chunk, below), _mm256_cmpgt_epi8(above, chunk))
+            ));
+        };
+        return static_cast<std::uint64_t>(lane(block + 32)) << 32 | lane(block);
+#elif defined(__SSE2__)
+        const auto below = _mm_set1_epi8(static_cast<char>(low - 1));
+        const auto above = _mm_set1_epi8(static_cast<char>(high + 1));
+        std::uint64_t mask = 0;
+        for (std::size_t i = 0; i < SCAN_BLOCK; i += 16) {
+            const auto chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(block + i));
+            const auto lane = static_cast<std::uint16_t>(_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpgt_epi8(chunk, below), _mm_cmpgt_epi8(above, chunk))
+            ));
+            mask |= static_cast<std::uint64_t>(lane) << i;
+        }
+        return mask;
+#else
+        std::uint64_t mask = 0;
+        for (std::size_t i = 0; i < SCAN_BLOCK; ++i) {
+            mask |= static_cast<std::uint64_t>(block[i] >= low && block[i] <= high) << i;
+        }
+        return mask;
+#endif
+    }
+
+    // Calls `f(index)` for every position of element in [data, data + length), in order, until f returns false.
+    template <class F>
+    void scan_matches(const char *data, const std::size_t length, const char element, const F &f) {
+        std::size_t i = 0;
+        for (; i + SCAN_BLOCK <= length; i += SCAN_BLOCK) {
+            for (auto mask = match_mask(data + i, element); mask != 0; mask &= mask - 1) {
+                if (!f(i + std::countr_zero(mask))) { return; }
+            }
+        }
+        for (; i < length; ++i) {
+            if (data[i] == element && !f(i)) { return; }
+        }
+    }
+
+    inline std::size_t count_matches(const char *data, const std::size_t length, const char element) {
+        std::size_t count = 0;
+        std::size_t i = 0;
+        for (; i + SCAN_BLOCK <= length; i += SCAN_BLOCK) { count += std::popcount(match_mask(data + i, element)); }
+        for (; i < length; ++i) { count += data[i] == element; }
+        return count;
+    }
+
+    // Monotonic arena for the containers a part builds and then drops all at once: allocations bump a pointer through
+    // blocks that only grow, deallocation is a no-op, and everything is handed back in one go on release() or
+    // destruction. Pass it wherever a std::pmr container takes a memory resource.
+    class Arena {
+        std::pmr::monotonic_buffer_resource memory;
+
+    public:
+        // Blocks come from the heap, the first one `initial_size` bytes.
+        explicit Arena(const std::size_t initial_size = 64 * 1024) : memory(std::max<std::size_t>(initial_size, 1)) {}
+        // Starts in `buffer`, typically on the stack, so a release() rewinds without touching the heap.
+        explicit Arena(const std::span<std::byte> buffer) : memory(buffer.data(), buffer.size()) {}
+        Arena(const Arena &) = delete;
+        Arena &operator=(const Arena &) = delete;
+
+        [[nodiscard]] std::pmr::memory_resource *resource() { return &memory; }
+        operator std::pmr::memory_resource *() { return &memory; }
+
+        // Frees every allocation at once, containers using the arena must be gone by then.
+        void release() { memory.release(); }
+    };
+
+    // One bit per cell, for visited or energized marks that do not need a full char Map. Bits past x_size() in the
+    // last word of a row are never set, so whole words can be counted and OR-ed.
+    class BitGrid {
+    public:
+        typedef std::uint64_t Word;
+        static constexpr std::size_t WORD_BITS = 64;
+
+    private:
+        std::size_t width;
+        std::size_t height;
+        std::size_t words_per_row;
+        std::vector<Word> words;
+
+        [[nodiscard]] std::size_t word_index(const X &x, const Y &y) const { return y * words_per_row + x / WORD_BITS; }
+        static Word bit(const X &x) { return static_cast<Word>(1) << (x % WORD_BITS); }
+
+    public:
+        explicit BitGrid(const std::size_t x_dimension, const std::size_t y_dimension)
+            : width(x_dimension), height(y_dimension), words_per_row((x_dimension + WORD_BITS - 1) / WORD_BITS),
+              words(words_per_row * y_dimension, 0) {}
+
+        [[nodiscard]] size_t x_size() const { return width; }
+        [[nodiscard]] size_t y_size() const { return height; }
+        [[nodiscard]] bool in_boundary(const Point &point) const { return point.x < x_size() && point.y < y_size(); }
+
+        [[nodiscard]] bool test(const X &x, const Y &y) const { return words[word_index(x, y)] & bit(x); }
+        [[nodiscard]] bool test(const Point &point) const { return test(point.x, point.y); }
+        void set(const X &x, const Y &y) { words[word_index(x, y)] |= bit(x); }
+        void set(const Point &point) { set(point.x, point.y); }
+        void reset(const X &x, const Y &y) { words[word_index(x, y)] &= ~bit(x); }
+        void reset(const Point &point) { reset(point.x, point.y); }
+        // Sets the bit and returns whether it was already set.
+        bool test_and_set(const X &x, const Y &y) {
+            auto &word = words[word_index(x, y)];
+            const bool was_set = word & bit(x);
+            word |= bit(x);
+            return was_set;
+        }
+        bool test_and_set(const Point &point) { return test_and_set(point.x, point.y); }
+
+        void clear() { std::ranges::fill(words, 0); }
+
+        [[nodiscard]] std::span<Word> row_words(const Y &y) { return {words.data() + y * words_per_row, words_per_row}; }
+        [[nodiscard]] std::span<const Word> row_words(const Y &y) const { return {words.data() + y * words_per_row, words_per_row}; }
+
+        [[nodiscard]] std::size_t count() const {
+            return std::transform_reduce(
+                words.begin(), words.end(),
+                static_cast<std::size_t>(0),
+                std::plus(),
+                [](const Word word) { return std::popcount(word); }
+            );
+        }
+        [[nodiscard]] std::size_t count_row(const Y &y) const {
+            const auto row = row_words(y);
+            return std::transform_reduce(
+                row.begin(), row.end(),
+                static_cast<std::size_t>(0),
+                std::plus(),
+                [](const Word word) { return std::popcount(word); }
+            );
+        }
+
+        // Row y |= other's row other_y, both grids must have the same width.
+        void or_row(const Y &y, const BitGrid &other, const Y &other_y) {
+            const auto source = other.row_words(other_y);
+            std::ranges::transform(row_words(y), source, row_words(y).begin(), std::bit_or());
+        }
+        BitGrid &operator|=(const BitGrid &other) {
+            std::ranges::transform(words, other.words, words.begin(), std::bit_or());
+            return *this;
+        }
+    };
+
     class Map {
+        // Row-major cells, `stride` chars per allocated row. `origin` is the index of (0, 0): a tight grid has it at 0
+        // and no headroom. Headroom is kept per side: expanding a side that has none reallocates with about the
+        // grid's extent added on that side only, so further expand_* calls on it just move the origin or the size.
+        // Each side thus reallocates O(log n) times over n expansions, the first expansion of every side included.
+        // `base` caches cells.data() + origin, so the hot accessors are one multiply and one add.
+        std::vector<char> cells;
+        std::size_t stride = 0;
+        std::size_t allocated_rows = 0;
+        std::size_t origin = 0;
+        std::size_t width = 0;
+        std::size_t height = 0;
+        char *base = nullptr;
+
+        void rebase() { base = cells.data() + origin; }
+
+        [[nodiscard]] std::size_t left_headroom() const { return origin % std::max<std::size_t>(stride, 1); }
+        [[nodiscard]] std::size_t top_headroom() const { return origin / std::max<std::size_t>(stride, 1); }
+        [[nodiscard]] std::size_t right_headroom() const { return stride - left_headroom() - width; }
+        [[nodiscard]] std::size_t bottom_headroom() const { return allocated_rows - top_headroom() - height; }
+
+        // Reallocates with at least the given headroom per side, each exhausted side grows geometrically.
+        void grow(const std::size_t left, const std::size_t top, const std::size_t right, const std::size_t bottom) {
+            const auto new_left = std::max(left_headroom(), left);
+            const auto new_top = std::max(top_headroom(), top);
+            const auto new_stride = new_left + width + std::max(right_headroom(), right);
+            const auto new_rows = new_top + height + std::max(bottom_headroom(), bottom);
+            std::vector<char> new_cells(new_stride * new_rows, EMPTY);
+            const auto new_origin = new_top * new_stride + new_left;
+            for (std::size_t y = 0; y < height; ++y) {
+                std::copy_n(base + y * stride, width, new_cells.begin() + new_origin + y * new_stride);
+            }
+            cells = std::move(new_cells);
+            stride = new_stride;
+            allocated_rows = new_rows;
+            origin = new_origin;
+            rebase();
+        }
+
     public:
         static constexpr char EMPTY = '.';
         static constexpr char BLOCKED = '#';
-        std::deque<std::deque<char>> map;
 
-        explicit Map(const std::size_t x_dimension, const std::size_t y_dimension) {
-            for (int y = 0; y < y_dimension; ++y) {
-                map.emplace_back(x_dimension, EMPTY);
+        explicit Map(const std::size_t x_dimension, const std::size_t y_dimension)
+            : cells(x_dimension * y_dimension, EMPTY), stride(x_dimension), allocated_rows(y_dimension),
+              width(x_dimension), height(y_dimension) {
+            rebase();
+        }
+
+        // Any range of rows, each a range of chars: input lines, strings or char vectors.
+        template <std::ranges::range TRows>
+        explicit Map(const TRows &map) {
+            for (const auto &line: map) {
+                width = std::max<std::size_t>(width, std::ranges::distance(line));
+                ++height;
+            }
+            stride = width;
+            allocated_rows = height;
+            cells.assign(width * height, EMPTY);
+            auto row_start = cells.begin();
+            for (const auto &line: map) {
+                std::ranges::copy(line, row_start);
+                row_start += stride;
             }
+            rebase();
         }
 
-        explicit Map(const std::vector<std::string> &map) {
-            std::ranges::transform(
-                map.begin(), map.end(),
-                std::back_inserter(this->map),
-                [](auto &line) {
-                    std::deque<char> row;
-                    std::copy(
-                        line.begin(), line.end(),
-                        std::back_inserter(row)
-                    );
-                    return std::move(row);
-                }
-            );
+        Map(const Map& other)
+            : cells(other.cells), stride(other.stride), allocated_rows(other.allocated_rows), origin(other.origin),
+              width(other.width), height(other.height) {
+            rebase();
         }
-        explicit Map(const std::vector<std::vector<char>> &map) {
-            std::ranges::transform(
-                map.begin(), map.end(),
-                std::back_inserter(this->map),
-                [](auto &line) {
-                    std::deque<char> row;
-                    std::copy(
-                        line.begin(), line.end(),
-                        std::back_inserter(row)
-                    );
-                    return std::move(row);
-                }
-            );
+        Map(Map&& other) noexcept
+            : cells(std::move(other.cells)), stride(other.stride), allocated_rows(other.allocated_rows),
+              origin(other.origin), width(other.width), height(other.height) {
+            rebase();
+        }
+        Map& operator=(const Map& other) {
+            if (this != &other) {
+                cells = other.cells;
+                stride = other.stride;
+                allocated_rows = other.allocated_rows;
+                origin = other.origin;
+                width = other.width;
+                height = other.height;
+                rebase();
+            }
+            return *this;
+        }
+        Map& operator=(Map&& other) noexcept {
+            cells = std::move(other.cells);
+            stride = other.stride;
+            allocated_rows = other.allocated_rows;
+            origin = other.origin;
+            width = other.width;
+            height = other.height;
+            rebase();
+            return *this;
         }
 
-        Map(const Map& other) = default;
+        [[nodiscard]] bool is_tight() const { return stride == width; }
 
         [[nodiscard]] Point find(const char element) const {
-            for (long i = 0; i < map.size(); ++i) {
-                if (auto it = std::ranges::find(map[i].begin(), map[i].end(), element); it != map[i].end()) {
-                    return Point{it - map[i].begin(), i};
-                }
+            for (long y = 0; y < y_size(); ++y) {
+                std::optional<X> found;
+                scan_matches(base + y * stride, width, element, [&found](const std::size_t x) {
+                    found = x;
+                    return false;
+                });
+                if (found.has_value()) { return Point{*found, y}; }
             }
             throw std::runtime_error("No start posion found");
         }
+        // A tight grid is scanned as one buffer, matches come in order so the row only ever moves forward.
         [[nodiscard]] std::vector<Point> find_all(const char element) const {
             std::vector<Point> found;
-            for (auto y = 0 ; y < y_size(); ++y) {
-                for (auto x = 0 ; x < x_size(); ++x) {
-                    if (at(x, y) == element) { found.emplace_back(x, y); }
-                }
+            if (is_tight() && width > 0) {
+                Y y = 0;
+                std::size_t row_end = width;
+                scan_matches(base, width * height, element, [&](const std::size_t index) {
+                    while (index >= row_end) {
+                        ++y;
+                        row_end += width;
+                    }
+                    found.emplace_back(index - (row_end - width), y);
+                    return true;
+                });
+                return found;
+            }
+            for (Y y = 0 ; y < y_size(); ++y) {
+                scan_matches(base + y * stride, width, element, [&found, y](const std::size_t x) {
+                    found.emplace_back(x, y);
+                    return true;
+                });
             }
             return found;
         }
+        [[nodiscard]] std::size_t count(const char element) const {
+            if (is_tight()) { return count_matches(base, width * height, element); }
+            std::size_t found = 0;
+            for (Y y = 0 ; y < y_size(); ++y) { found += count_matches(base + y * stride, width, element); }
+            return found;
+        }
 
-        [[nodiscard]] size_t x_size() const { return map.front().size(); }
-        [[nodiscard]] size_t y_size() const { return map.size(); }
+        [[nodiscard]] size_t x_size() const { return width; }
+        [[nodiscard]] size_t y_size() const { return height; }
 
         [[nodiscard]] bool in_x_boundary(const X &x) const { return x < x_size(); }
         [[nodiscard]] bool in_y_boundary(const Y &y) const { return y < y_size(); }
         [[nodiscard]] bool in_boundary(const Point &point) const { return in_x_boundary(point.x) && in_y_boundary(point.y); }
 
-        [[nodiscard]] char at(const X &x, const Y &y) const {  return map[y][x]; }
+        [[nodiscard]] char at(const X &x, const Y &y) const {  return base[y * stride + x]; }
         [[nodiscard]] char at(const Point& point) const { return at(point.x, point.y);  }
         char operator[](const Point& point) const { return at(point.x, point.y);  }
 
-        void set(const X &x, const Y &y, const char &value) { map[y][x] = value; }
+        void set(const X &x, const Y &y, const char &value) { base[y * stride + x] = value; }
         void set(const Point& point, const char &value) { set(point.x, point.y, value); }
 
+        [[nodiscard]] std::span<char> row(const Y &y) { return {base + y * stride, width}; }
+        [[nodiscard]] std::span<const char> row(const Y &y) const { return {base + y * stride, width}; }
+
         void expand_up() {
-            map.emplace_front(x_size(), EMPTY);
+            if (top_headroom() == 0) { grow(0, height + 1, 0, 0); }
+            origin -= stride;
+            rebase();
+            ++height;
+            std::ranges::fill(row(0), EMPTY);
         }
         void expand_down() {
-            map.emplace_back(x_size(), EMPTY);
+            if (bottom_headroom() == 0) { grow(0, 0, 0, height + 1); }
+            ++height;
+            std::ranges::fill(row(height - 1), EMPTY);
         }
         void expand_right() {
-            for (auto& row : map) {
-                row.emplace_back(EMPTY);
-            }
+            if (right_headroom() == 0) { grow(0, 0, width + 1, 0); }
+            ++width;
+            for (Y y = 0; y < height; ++y) { set(width - 1, y, EMPTY); }
         }
         void expand_left() {
-            for (auto& row : map) {
-                row.emplace_front(EMPTY);
-            }
+            if (left_headroom() == 0) { grow(width + 1, 0, 0, 0); }
+            --origin;
+            rebase();
+            ++width;
+            for (Y y = 0; y < height; ++y) { set(0, y, EMPTY); }
         }
 
-        void paint_exterior(const char paint) {
-            expand_up();
-            expand_down();
-            expand_right();
-            expand_left();
-            std::set<Point> visited_cells;
-            std::deque<Point> explore_cells;
-            explore_cells.emplace_back(0, 0);
-            set(0, 0, paint);
-            while (!explore_cells.empty()) {
-                const auto point = explore_cells.front();
-                explore_cells.pop_front();
-                if (const auto north = Point(point.x, point.north());
-                    in_y_boundary(north.y) && at(north) == EMPTY && !visited_cells.contains(north)
-                ) {
-                    explore_cells.push_back(north);
-                    set(point.x, point.north(), paint);
-                    visited_cells.insert(north);
-                }
-                if (const auto south = Point(point.x, point.south());
-                    in_y_boundary(south.y) && at(south) == EMPTY && !visited_cells.contains(south)
-                ) {
-                    explore_cells.push_back(south);
-                    set(point.x, point.south(), paint);
-                    visited_cells.insert(south);
-                }
-                if (const auto east = Point(point.east(), point.y);
-                    in_x_boundary(east.x) && at(east) == EMPTY && !visited_cells.contains(east)
-                ) {
-                    explore_cells.push_back(east);
-                    set(point.east(), point.y, paint);
-                    visited_cells.insert(east);
-                }
-                if (const auto west = Point(point.west(), point.y);
-                    in_x_boundary(west.x) && at(west) == EMPTY && !visited_cells.contains(west)
-                ) {
-                    explore_cells.push_back(west);
-                    set(point.west(), point.y, paint);
-                    visited_cells.insert(west);
-                }
-            }
-        }
+        void paint_exterior(const char paint);
 
         void print() const {
             std::cout << *this << std::endl;
@@ -196,14 +451,64 @@ namespace ElvenUtils {
         friend std::ostream& operator<<(std::ostream& os, const Map& map);
     };
 
+    // Scanline flood fill from `start` over the cells accepted by `passable(cell)`, painting them with `paint`. Whole
+    // horizontal runs are filled at once and only one seed per run of the rows above and below is kept on the stack,
+    // visited cells are tracked in a BitGrid so `paint` may itself be passable. Returns the number of filled cells.
+    template <class Passable>
+    std::size_t flood_fill(Map &map, const Point &start, const Passable &passable, const char paint) {
+        if (!map.in_boundary(start) || !passable(map.at(start))) { return 0; }
+
+        const auto is_open = [&map, &passable](const BitGrid &visited, const X x, const Y y) {
+            return !visited.test(x, y) && passable(map.at(x, y));
+        };
+        BitGrid visited(map.x_size(), map.y_size());
+        std::vector<Point> seeds;
+        seeds.push_back(start);
+        std::size_t filled = 0;
+        while (!seeds.empty()) {
+            const auto seed = seeds.back();
+            seeds.pop_back();
+            if (!is_open(visited, seed.x, seed.y)) { continue; }
+
+            X left = seed.x;
+            while (left > 0 && is_open(visited, left - 1, seed.y)) { --left; }
+            X right = seed.x;
+            while (map.in_x_boundary(right + 1) && is_open(visited, right + 1, seed.y)) { ++right; }
+            for (X x = left; x <= right; ++x) {
+                visited.set(x, seed.y);
+                map.set(x, seed.y, paint);
+            }
+            filled += right - left + 1;
+
+            for (const Y y : {seed.up(), seed.down()}) {
+                if (!map.in_y_boundary(y)) { continue; }
+                bool previous_open = false;
+                for (X x = left; x <= right; ++x) {
+                    const bool open = is_open(visited, x, y);
+                    if (open && !previous_open) { seeds.emplace_back(x, y); }
+                    previous_open = open;
+                }
+            }
+        }
+        return filled;
+    }
+
+    inline void Map::paint_exterior(const char paint) {
+        expand_up();
+        expand_down();
+        expand_right();
+        expand_left();
+        flood_fill(*this, Point(0, 0), [](const char cell) { return cell == EMPTY; }, paint);
+    }
+
     inline std::ostream& operator<<(std::ostream& os, const Point& point) {
         os << "(" << point.x << "," << point.y << ")";
         return os;
     }
 
     inline std::ostream& operator<<(std::ostream& os, const Map& map) {
-        for (const auto &row: map.map) {
-            for (const auto &cell: row) { os << cell; }
+        for (Y y = 0; y < map.y_size(); ++y) {
+            for (const auto &cell: map.row(y)) { os << cell; }
             os << std::endl;
         }
         return os;
@@ -1,21 +1,18 @@
 #include <map>
 #include <numeric>
-#include <sstream>
 
 #include "elven_io.h"
 #include "elven_measure.h"
+#include "elven_parse.h"
 
 
 auto parse(const ElvenIO::input_type &input) {
     std::vector<int> left_list;
     std::vector<int> right_list;
     for (const auto &line : input) {
-        std::stringstream stream;
-        stream << line;
-        int left, right;
-        stream >> left >> right;
-        left_list.push_back(left);
-        right_list.push_back(right);
+        ElvenParse::Cursor cursor(line);
+        left_list.push_back(cursor.read_int<int>());
+        right_list.push_back(cursor.read_int<int>());
     }
     return std::make_pair(left_list, right_list);
 }